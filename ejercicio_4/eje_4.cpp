@@ -1,6 +1,16 @@
 #include <iostream>
 #include <cmath>
 #include <initializer_list> // Para la función acumula
+#include <vector>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <random>
+#include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <cstdint>
 using namespace std;
 
 // ==================================================
@@ -67,6 +77,22 @@ public:
         return Complejo(real, imag);
     }
 
+    // -------------------------------
+    // División robusta (algoritmo de Smith): evita el desbordamiento
+    // de c² + d² cuando el divisor es muy grande o muy pequeño
+    // -------------------------------
+    Complejo dividirSmith(const Complejo& otro) const {
+        double c = otro.parteReal, d = otro.parteImag;
+        if (fabs(c) >= fabs(d)) {
+            double r = d / c;
+            double den = c + d * r;
+            return Complejo((parteReal + parteImag * r) / den, (parteImag - parteReal * r) / den);
+        }
+        double r = c / d;
+        double den = c * r + d;
+        return Complejo((parteReal * r + parteImag) / den, (parteImag * r - parteReal) / den);
+    }
+
     // -------------------------------
     // Funciones para conversión a forma polar
     // -------------------------------
@@ -83,6 +109,79 @@ public:
     double getImag() const { return parteImag; }
 };
 
+// ==================================================
+// Recíproco precalculado de un divisor fijo: convierte divisiones
+// repetidas por el mismo complejo en multiplicaciones.
+// El divisor se escala por una potencia de dos (exacta) antes de
+// invertirlo con Smith. Si 1/divisor es un double normal, la escala se
+// incorpora al recíproco; si no (divisores cercanos a los subnormales o
+// a DBL_MAX), se aplica después del producto para no perder precisión.
+// ==================================================
+class ReciprocoComplejo {
+private:
+    double invReal, invImag;  // 1/divisor, o 1/(divisor·2^-k) si no es directo
+    double escalaA, escalaB;  // 2^-k repartido en dos factores representables
+    bool directo;             // true: basta multiplicar por (invReal, invImag)
+
+public:
+    // -------------------------------
+    // Constructor: prepara el recíproco del divisor
+    // -------------------------------
+    explicit ReciprocoComplejo(const Complejo& divisor) {
+        double mayor = max(fabs(divisor.getReal()), fabs(divisor.getImag()));
+        int k = (mayor > 0 && isfinite(mayor)) ? ilogb(mayor) : 0;
+        Complejo escalado(ldexp(divisor.getReal(), -k), ldexp(divisor.getImag(), -k));
+        Complejo inverso = Complejo(1, 0).dividirSmith(escalado);
+        escalaA = ldexp(1.0, -k / 2);
+        escalaB = ldexp(1.0, -k - (-k / 2));
+        directo = abs(k) < 1000;
+        invReal = directo ? ldexp(inverso.getReal(), -k) : inverso.getReal();
+        invImag = directo ? ldexp(inverso.getImag(), -k) : inverso.getImag();
+    }
+
+    bool esDirecto() const { return directo; }
+
+    // -------------------------------
+    // a / divisor como una multiplicación
+    // -------------------------------
+    Complejo dividir(const Complejo& a) const {
+        double re = a.getReal() * invReal - a.getImag() * invImag;
+        double im = a.getReal() * invImag + a.getImag() * invReal;
+        if (directo)
+            return Complejo(re, im);
+        return Complejo(re * escalaA * escalaB, im * escalaA * escalaB);
+    }
+
+    // -------------------------------
+    // Kernel por lotes (salida puede coincidir con entrada)
+    // -------------------------------
+    void dividir(const Complejo* entrada, Complejo* salida, size_t n) const {
+        const double ir = invReal, ii = invImag;
+        if (directo) {
+            for (size_t i = 0; i < n; ++i) {
+                double ar = entrada[i].getReal(), ai = entrada[i].getImag();
+                salida[i] = Complejo(ar * ir - ai * ii, ar * ii + ai * ir);
+            }
+            return;
+        }
+        for (size_t i = 0; i < n; ++i)
+            salida[i] = dividir(entrada[i]);
+    }
+};
+
+// Permite escribir a / ReciprocoComplejo(d)
+inline Complejo operator/(const Complejo& a, const ReciprocoComplejo& reciproco) {
+    return reciproco.dividir(a);
+}
+
+// ==================================================
+// Kernel por lotes: divide un arreglo completo por el mismo complejo
+// (salida puede coincidir con entrada)
+// ==================================================
+void dividirLote(const Complejo* entrada, Complejo* salida, size_t n, const Complejo& divisor) {
+    ReciprocoComplejo(divisor).dividir(entrada, salida, n);
+}
+
 // ==================================================
 // Clase para números complejos en forma polar (r·e^{iθ})
 // ==================================================
@@ -142,21 +241,1053 @@ public:
     double getAngulo() const { return angulo; }
 };
 
+// ==================================================
+// Conversión por lotes entre Complejo y Polar
+// ==================================================
+enum class PrecisionConversion {
+    Exacta,  // Mismo resultado que los métodos escalares (cos, sin, atan2 de libm)
+    Rapida   // Aproximaciones sin ramas y vectorizables (cota de error abajo)
+};
+
+// Cota documentada del modo Rápido, medida con ./eje_4 --bench:
+//   seno/coseno : error absoluto ≤ 2^-52 (COTA_SENO_RAPIDO) para
+//                 |θ| ≤ LIMITE_SENO_RAPIDO; ≤ 2 ULP donde |resultado| ≥ 1/2.
+//                 Cerca de los ceros (θ ≈ kπ/2) el error relativo no está
+//                 acotado: la reducción por π/2 cancela casi todos los bits
+//   atan2       : ≤ 3 ULP para argumentos finitos
+// Fuera de ese dominio (|θ| grande, infinitos, NaN) se usa libm.
+// Para que los lazos se vectoricen: -O3 -march=native -fno-math-errno
+const double LIMITE_SENO_RAPIDO = 8.0e5;
+const double COTA_SENO_RAPIDO = 2.220446049250313e-16;  // 2^-52
+
+// -------------------------------
+// Seno y coseno simultáneos: reducción de Cody-Waite por π/2 y
+// polinomios minimax de fdlibm en [-π/4, π/4]. Sin ramas, para que
+// el compilador pueda vectorizar el lazo que lo llama.
+// -------------------------------
+inline void senoCosenoRapido(double x, double& seno, double& coseno) {
+    const double DOS_SOBRE_PI = 6.36619772367581382433e-01;
+    const double PIO2_1 = 1.57079632673412561417e+00;  // π/2 en tres partes
+    const double PIO2_2 = 6.07710050630396597660e-11;
+    const double PIO2_3 = 2.02226624871116645580e-21;
+    const double REDONDEO = 6755399441055744.0;         // 1.5·2^52
+
+    double k = (x * DOS_SOBRE_PI + REDONDEO) - REDONDEO;  // Entero más cercano
+    double r = ((x - k * PIO2_1) - k * PIO2_2) - k * PIO2_3;
+
+    double z = r * r;
+    double s = r + r * z * (-1.66666666666666324348e-01 + z * (8.33333333332248946124e-03 +
+               z * (-1.98412698298579493134e-04 + z * (2.75573137070700676789e-06 +
+               z * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10)))));
+    double c = 1.0 - 0.5 * z + z * z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 +
+               z * (2.48015872894767294178e-05 + z * (-2.75573143513906633035e-07 +
+               z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11)))));
+
+    // Cuadrante q = k mod 4, calculado en double para no romper la vectorización
+    double q = k - 4.0 * ((k * 0.25 - 0.375 + REDONDEO) - REDONDEO);
+    bool intercambiar = (q == 1.0 || q == 3.0);
+    double sBase = intercambiar ? c : s;
+    double cBase = intercambiar ? s : c;
+    seno = (q >= 2.0) ? -sBase : sBase;
+    coseno = (q == 1.0 || q == 2.0) ? -cBase : cBase;
+}
+
+// -------------------------------
+// atan2 sin ramas: se reduce a atan(t) con t ∈ [0, 1], luego a
+// |u| ≤ tan(π/8) con atan(t) = π/4 + atan((t-1)/(t+1)), y se evalúa
+// el polinomio de fdlibm (válido para |u| ≤ 7/16).
+// -------------------------------
+inline double atan2Rapido(double y, double x) {
+    const double PI = 3.14159265358979311600e+00;
+    const double PI_2 = 1.57079632679489655800e+00;
+    const double PI_4 = 7.85398163397448278999e-01;
+    const double TAN_PI_8 = 4.14213562373095034e-01;
+
+    double ax = fabs(x), ay = fabs(y);
+    double mayor = ax > ay ? ax : ay;
+    double menor = ax > ay ? ay : ax;
+    double t = menor / (mayor == 0.0 ? 1.0 : mayor);
+
+    // Ambas ramas se calculan siempre; la selección final no tiene saltos
+    bool desplazar = t > TAN_PI_8;
+    double uDesplazado = (t - 1.0) / (t + 1.0);
+    double u = desplazar ? uDesplazado : t;
+    double z = u * u, w = z * z;
+    double s1 = z * (3.33333333333329318027e-01 + w * (1.42857142725034663711e-01 +
+                w * (9.09088713343650656196e-02 + w * (6.66107313738753120669e-02 +
+                w * (4.97687799461593236017e-02 + w * 1.62858201153657823623e-02)))));
+    double s2 = w * (-1.99999999998764832476e-01 + w * (-1.11111104054623557880e-01 +
+                w * (-7.69187620504482999495e-02 + w * (-5.83357013379057348645e-02 +
+                w * -3.65315727442169155270e-02))));
+    double a = u - u * (s1 + s2);
+    a = desplazar ? PI_4 + a : a;
+
+    a = ay > ax ? PI_2 - a : a;
+    a = copysign(1.0, x) < 0.0 ? PI - a : a;  // Respeta x = -0 como atan2
+    return copysign(a, y);
+}
+
+// -------------------------------
+// Lote binomial → polar
+// -------------------------------
+void convertirLoteAPolar(const Complejo* entrada, Polar* salida, size_t n,
+                         PrecisionConversion precision = PrecisionConversion::Exacta) {
+    if (precision == PrecisionConversion::Exacta) {
+        for (size_t i = 0; i < n; ++i)
+            salida[i] = Polar::desdeBinomial(entrada[i]);
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        double re = entrada[i].getReal(), im = entrada[i].getImag();
+        salida[i] = Polar(sqrt(re * re + im * im), atan2Rapido(im, re));
+    }
+
+    // Casos fuera del dominio de la aproximación
+    for (size_t i = 0; i < n; ++i)
+        if (!isfinite(entrada[i].getReal()) || !isfinite(entrada[i].getImag()))
+            salida[i] = Polar::desdeBinomial(entrada[i]);
+}
+
+// -------------------------------
+// Lote polar → binomial
+// -------------------------------
+void convertirLoteABinomial(const Polar* entrada, Complejo* salida, size_t n,
+                            PrecisionConversion precision = PrecisionConversion::Exacta) {
+    if (precision == PrecisionConversion::Exacta) {
+        for (size_t i = 0; i < n; ++i)
+            salida[i] = entrada[i].convertirABinomial();
+        return;
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        double s, c;
+        senoCosenoRapido(entrada[i].getAngulo(), s, c);
+        double r = entrada[i].getMagnitud();
+        salida[i] = Complejo(r * c, r * s);
+    }
+
+    // Ángulos fuera del rango de reducción (incluye infinitos y NaN)
+    for (size_t i = 0; i < n; ++i)
+        if (!(fabs(entrada[i].getAngulo()) <= LIMITE_SENO_RAPIDO))
+            salida[i] = entrada[i].convertirABinomial();
+}
+
+// Versiones sobre vectores completos
+vector<Polar> convertirLoteAPolar(const vector<Complejo>& entrada,
+                                  PrecisionConversion precision = PrecisionConversion::Exacta) {
+    vector<Polar> salida(entrada.size());
+    convertirLoteAPolar(entrada.data(), salida.data(), entrada.size(), precision);
+    return salida;
+}
+
+vector<Complejo> convertirLoteABinomial(const vector<Polar>& entrada,
+                                        PrecisionConversion precision = PrecisionConversion::Exacta) {
+    vector<Complejo> salida(entrada.size());
+    convertirLoteABinomial(entrada.data(), salida.data(), entrada.size(), precision);
+    return salida;
+}
+
+// ==================================================
+// Complejo adaptable: guarda la forma binomial, la polar o ambas, y
+// convierte de forma perezosa solo cuando una operación lo exige.
+// Suma/resta trabajan en binomial; producto/cociente eligen la forma
+// que requiera menos conversiones. En empate se usa binomial, porque es
+// la forma que admite las cuatro operaciones sin volver a convertir.
+// Un mismo objeto no es seguro entre hilos: las operaciones const
+// completan la caché (campos mutable), así que dos hilos que solo leen el
+// mismo objeto ya compiten. Objetos distintos sí se pueden usar en hilos
+// distintos: los contadores compartidos son atómicos.
+// ==================================================
+struct EstadisticasConversion {
+    long long realizadas = 0;  // Conversiones (sqrt/atan2 o cos/sin) ejecutadas
+    long long evitadas = 0;    // Conversiones que un esquema ansioso sí habría hecho
+};
+
+// Contadores compartidos por todos los objetos; incrementos relajados
+// (solo se suman, no ordenan otros accesos)
+struct ContadoresConversion {
+    atomic<long long> realizadas{0};
+    atomic<long long> evitadas{0};
+
+    void realizada() { realizadas.fetch_add(1, memory_order_relaxed); }
+    void evitada() { evitadas.fetch_add(1, memory_order_relaxed); }
+};
+
+class ComplejoAdaptable {
+private:
+    enum class Forma { Binomial, Polar };
+
+    // Caché de formas: se completa desde métodos const (sin sincronización)
+    mutable Complejo binomial;   // Valor en forma binomial (si tieneBinomial)
+    mutable Polar polar;         // Valor en forma polar (si tienePolar)
+    mutable bool tieneBinomial;
+    mutable bool tienePolar;
+    Forma origen;                // Forma en la que se produjo el valor
+
+    // Contadores globales (atómicos: objetos en hilos distintos los comparten)
+    inline static ContadoresConversion contadores;
+
+    // -------------------------------
+    // Garantiza la forma pedida; cuenta conversión o acierto de caché
+    // -------------------------------
+    void asegurarBinomial() const {
+        if (tieneBinomial) {
+            if (origen != Forma::Binomial) contadores.evitada();
+            return;
+        }
+        binomial = polar.convertirABinomial();
+        tieneBinomial = true;
+        contadores.realizada();
+    }
+
+    void asegurarPolar() const {
+        if (tienePolar) {
+            if (origen != Forma::Polar) contadores.evitada();
+            return;
+        }
+        polar = Polar::desdeBinomial(binomial);
+        tienePolar = true;
+        contadores.realizada();
+    }
+
+    // Cuántas conversiones exigiría operar ambos en la forma indicada
+    static int costo(const ComplejoAdaptable& a, const ComplejoAdaptable& b, Forma f) {
+        if (f == Forma::Polar) return !a.tienePolar + !b.tienePolar;
+        return !a.tieneBinomial + !b.tieneBinomial;
+    }
+
+    // Operando consumido en forma binomial cuando un esquema ansioso
+    // lo habría pasado a polar para multiplicar o dividir
+    static void operarEnBinomial(const ComplejoAdaptable& a, const ComplejoAdaptable& b) {
+        for (const ComplejoAdaptable* x : {&a, &b}) {
+            if (x->origen == Forma::Binomial) contadores.evitada();
+            x->asegurarBinomial();
+        }
+    }
+
+public:
+    // -------------------------------
+    // Constructores desde cada forma
+    // -------------------------------
+    ComplejoAdaptable(const Complejo& c = Complejo())
+        : binomial(c), tieneBinomial(true), tienePolar(false), origen(Forma::Binomial) {}
+
+    ComplejoAdaptable(const Polar& p)
+        : polar(p), tieneBinomial(false), tienePolar(true), origen(Forma::Polar) {}
+
+    // -------------------------------
+    // Acceso a cada forma (convierte si hace falta)
+    // -------------------------------
+    Complejo comoBinomial() const { asegurarBinomial(); return binomial; }
+    Polar comoPolar() const { asegurarPolar(); return polar; }
+
+    bool tieneFormaBinomial() const { return tieneBinomial; }
+    bool tieneFormaPolar() const { return tienePolar; }
+
+    // -------------------------------
+    // Suma y resta (siempre en binomial)
+    // -------------------------------
+    ComplejoAdaptable operator+(const ComplejoAdaptable& otro) const {
+        asegurarBinomial();
+        otro.asegurarBinomial();
+        return ComplejoAdaptable(binomial + otro.binomial);
+    }
+
+    ComplejoAdaptable operator-(const ComplejoAdaptable& otro) const {
+        asegurarBinomial();
+        otro.asegurarBinomial();
+        return ComplejoAdaptable(binomial - otro.binomial);
+    }
+
+    // -------------------------------
+    // Producto y cociente (forma más barata)
+    // -------------------------------
+    ComplejoAdaptable operator*(const ComplejoAdaptable& otro) const {
+        if (costo(*this, otro, Forma::Binomial) <= costo(*this, otro, Forma::Polar)) {
+            operarEnBinomial(*this, otro);
+            return ComplejoAdaptable(binomial * otro.binomial);
+        }
+        asegurarPolar();
+        otro.asegurarPolar();
+        return ComplejoAdaptable(polar * otro.polar);
+    }
+
+    ComplejoAdaptable operator/(const ComplejoAdaptable& otro) const {
+        if (costo(*this, otro, Forma::Binomial) <= costo(*this, otro, Forma::Polar)) {
+            operarEnBinomial(*this, otro);
+            return ComplejoAdaptable(binomial / otro.binomial);
+        }
+        asegurarPolar();
+        otro.asegurarPolar();
+        return ComplejoAdaptable(polar / otro.polar);
+    }
+
+    // -------------------------------
+    // Conjugado: se aplica a todas las formas válidas, sin convertir
+    // -------------------------------
+    ComplejoAdaptable conjugar() const {
+        ComplejoAdaptable r = *this;
+        if (tieneBinomial) r.binomial = binomial.conjugar();
+        if (tienePolar) r.polar = polar.conjugar();
+        return r;
+    }
+
+    // -------------------------------
+    // Mostrar en la forma en que se produjo
+    // -------------------------------
+    void mostrar() const {
+        if (origen == Forma::Polar) polar.mostrar();
+        else binomial.mostrar();
+    }
+
+    // -------------------------------
+    // Contadores de conversiones
+    // -------------------------------
+    static EstadisticasConversion estadisticas() {
+        EstadisticasConversion e;
+        e.realizadas = contadores.realizadas.load(memory_order_relaxed);
+        e.evitadas = contadores.evitadas.load(memory_order_relaxed);
+        return e;
+    }
+    static void reiniciarEstadisticas() {
+        contadores.realizadas.store(0, memory_order_relaxed);
+        contadores.evitadas.store(0, memory_order_relaxed);
+    }
+};
+
+// ==================================================
+// Modos de suma disponibles para acumular complejos
+// ==================================================
+enum class ModoSuma {
+    Ingenuo,  // Suma directa término a término (comportamiento original)
+    Kahan,    // Suma compensada de Kahan-Neumaier
+    Pares     // Suma por pares (pairwise), error O(log n)
+};
+
+// ==================================================
+// Suma compensada de Kahan-Neumaier para una componente real
+// ==================================================
+struct SumaCompensada {
+    double suma = 0;          // Suma acumulada
+    double compensacion = 0;  // Error de redondeo acumulado
+
+    void agregar(double x) {
+        double t = suma + x;
+        if (fabs(suma) >= fabs(x))
+            compensacion += (suma - t) + x;
+        else
+            compensacion += (x - t) + suma;
+        suma = t;
+    }
+
+    double total() const { return suma + compensacion; }
+};
+
+// Tamaño fijo de bloque: los límites no dependen del número de hilos,
+// por eso el resultado es idéntico con 1 o con N hilos
+const size_t TAM_BLOQUE_SUMA = 1 << 15;
+
+// Por debajo de este tamaño la suma por pares usa un lazo directo
+const size_t TAM_BASE_PARES = 64;
+
+// ==================================================
+// Suma por pares de un arreglo contiguo de complejos
+// ==================================================
+Complejo sumaPorPares(const Complejo* datos, size_t n) {
+    if (n <= TAM_BASE_PARES) {
+        double re = 0, im = 0;
+        for (size_t i = 0; i < n; ++i) {
+            re += datos[i].getReal();
+            im += datos[i].getImag();
+        }
+        return Complejo(re, im);
+    }
+    size_t mitad = n / 2;
+    return sumaPorPares(datos, mitad) + sumaPorPares(datos + mitad, n - mitad);
+}
+
+// ==================================================
+// Suma un bloque contiguo con el modo indicado (sin hilos)
+// ==================================================
+Complejo sumarBloque(const Complejo* datos, size_t n, ModoSuma modo) {
+    if (modo == ModoSuma::Pares)
+        return sumaPorPares(datos, n);
+
+    if (modo == ModoSuma::Kahan) {
+        SumaCompensada re, im;
+        for (size_t i = 0; i < n; ++i) {
+            re.agregar(datos[i].getReal());
+            im.agregar(datos[i].getImag());
+        }
+        return Complejo(re.total(), im.total());
+    }
+
+    Complejo sumaTotal(0, 0);
+    for (size_t i = 0; i < n; ++i)
+        sumaTotal = sumaTotal + datos[i];
+    return sumaTotal;
+}
+
+// ==================================================
+// Acumulador por flujo: recibe los datos en trozos de cualquier tamaño
+// (lectores por bloques, archivos, sockets...). El resultado no depende
+// de cómo se partió la entrada.
+// ==================================================
+class AcumuladorComplejo {
+private:
+    ModoSuma modo;
+    SumaCompensada real, imag;      // Usados por los modos Ingenuo y Kahan
+    vector<Complejo> bloque;        // Bloque en construcción (modo Pares)
+    vector<Complejo> niveles;       // Cascada binaria de sumas de bloques
+    vector<bool> nivelOcupado;
+
+    // Sube la suma de un bloque completo por la cascada (como un contador binario)
+    void cerrarBloque() {
+        Complejo acarreo = sumaPorPares(bloque.data(), bloque.size());
+        bloque.clear();
+        for (size_t k = 0;; ++k) {
+            if (k == niveles.size()) {
+                niveles.push_back(acarreo);
+                nivelOcupado.push_back(true);
+                return;
+            }
+            if (!nivelOcupado[k]) {
+                niveles[k] = acarreo;
+                nivelOcupado[k] = true;
+                return;
+            }
+            acarreo = niveles[k] + acarreo;
+            nivelOcupado[k] = false;
+        }
+    }
+
+public:
+    // -------------------------------
+    // Constructor: elige el modo de suma
+    // -------------------------------
+    AcumuladorComplejo(ModoSuma m = ModoSuma::Kahan) : modo(m) {
+        if (modo == ModoSuma::Pares)
+            bloque.reserve(TAM_BLOQUE_SUMA);
+    }
+
+    // -------------------------------
+    // Agregar un solo valor
+    // -------------------------------
+    void agregar(const Complejo& c) {
+        if (modo == ModoSuma::Pares) {
+            bloque.push_back(c);
+            if (bloque.size() == TAM_BLOQUE_SUMA)
+                cerrarBloque();
+        } else if (modo == ModoSuma::Kahan) {
+            real.agregar(c.getReal());
+            imag.agregar(c.getImag());
+        } else {
+            real.suma += c.getReal();
+            imag.suma += c.getImag();
+        }
+    }
+
+    // -------------------------------
+    // Agregar un trozo contiguo de valores
+    // -------------------------------
+    void agregar(const Complejo* datos, size_t n) {
+        for (size_t i = 0; i < n; ++i)
+            agregar(datos[i]);
+    }
+
+    // -------------------------------
+    // Suma de todo lo recibido hasta ahora
+    // -------------------------------
+    Complejo resultado() const {
+        if (modo != ModoSuma::Pares)
+            return Complejo(real.total(), imag.total());
+
+        Complejo total = sumaPorPares(bloque.data(), bloque.size());
+        for (size_t k = niveles.size(); k-- > 0;)
+            if (nivelOcupado[k])
+                total = niveles[k] + total;
+        return total;
+    }
+};
+
+// ==================================================
+// Acumular un arreglo contiguo repartiendo bloques entre hilos.
+// hilos = 0 usa todos los núcleos disponibles.
+// ==================================================
+Complejo acumular(const Complejo* datos, size_t n,
+                  ModoSuma modo = ModoSuma::Kahan, unsigned hilos = 0) {
+    size_t totalBloques = (n + TAM_BLOQUE_SUMA - 1) / TAM_BLOQUE_SUMA;
+
+    // El modo ingenuo se conserva secuencial: es la referencia original
+    if (modo == ModoSuma::Ingenuo || totalBloques <= 1)
+        return sumarBloque(datos, n, modo);
+
+    if (hilos == 0)
+        hilos = max(1u, thread::hardware_concurrency());
+    hilos = (unsigned)min<size_t>(hilos, totalBloques);
+
+    // Cada bloque escribe su suma parcial en una posición fija
+    vector<Complejo> parciales(totalBloques);
+    auto trabajar = [&](unsigned id) {
+        for (size_t b = id; b < totalBloques; b += hilos) {
+            size_t inicio = b * TAM_BLOQUE_SUMA;
+            parciales[b] = sumarBloque(datos + inicio, min(TAM_BLOQUE_SUMA, n - inicio), modo);
+        }
+    };
+
+    vector<thread> grupo;
+    for (unsigned id = 1; id < hilos; ++id)
+        grupo.emplace_back(trabajar, id);
+    trabajar(0);
+    for (auto& h : grupo)
+        h.join();
+
+    // Combinación final en orden fijo de bloque
+    return sumarBloque(parciales.data(), parciales.size(), modo);
+}
+
+// ==================================================
+// Acumular un vector completo
+// ==================================================
+Complejo acumular(const vector<Complejo>& valores,
+                  ModoSuma modo = ModoSuma::Kahan, unsigned hilos = 0) {
+    return acumular(valores.data(), valores.size(), modo, hilos);
+}
+
+// ==================================================
+// Acumular desde cualquier par de iteradores (listas, flujos, etc.)
+// ==================================================
+template <typename Iterador>
+Complejo acumular(Iterador inicio, Iterador fin, ModoSuma modo = ModoSuma::Kahan) {
+    AcumuladorComplejo acumulador(modo);
+    for (; inicio != fin; ++inicio)
+        acumulador.agregar(*inicio);
+    return acumulador.resultado();
+}
+
 // ==================================================
 // Función para acumular varios números (complejos o polares)
 // ==================================================
 Complejo acumular(std::initializer_list<Complejo> lista) {
-    Complejo sumaTotal(0, 0);
-    for (auto& elem : lista) {
-        sumaTotal = sumaTotal + elem;
+    return acumular(lista.begin(), lista.size());
+}
+
+// ==================================================
+// Renderizador de fractales de tiempo de escape (Mandelbrot / Julia)
+// Carga de trabajo de referencia para la aritmética de Complejo.
+// ==================================================
+struct ParametrosFractal {
+    int ancho = 1024;                 // Píxeles por fila
+    int alto = 768;                   // Filas
+    int maxIteraciones = 1000;        // Límite de iteraciones por píxel
+    double centroReal = -0.5;         // Centro de la vista
+    double centroImag = 0.0;
+    double anchoVista = 3.0;          // Ancho de la vista en el plano complejo
+    bool julia = false;               // false: Mandelbrot, true: Julia
+    Complejo constanteJulia = Complejo(-0.8, 0.156);
+    bool simd = true;                 // Iterar varios píxeles a la vez
+    unsigned hilos = 0;               // 0: todos los núcleos
+    int tamTesela = 32;               // Lado de cada tesela cuadrada
+};
+
+// Píxeles que avanzan juntos en la ruta SIMD
+const int CARRILES_FRACTAL = 8;
+
+// -------------------------------
+// Punto del plano complejo que corresponde al píxel (x, y)
+// -------------------------------
+Complejo puntoDePixel(const ParametrosFractal& p, int x, int y) {
+    double paso = p.anchoVista / p.ancho;
+    return Complejo(p.centroReal + (x - p.ancho / 2.0) * paso,
+                    p.centroImag - (y - p.alto / 2.0) * paso);
+}
+
+// -------------------------------
+// Ruta escalar: un píxel con los operadores de Complejo
+// -------------------------------
+int iterarPixel(const ParametrosFractal& p, const Complejo& punto) {
+    Complejo z = p.julia ? punto : Complejo(0, 0);
+    Complejo c = p.julia ? p.constanteJulia : punto;
+    int n = 0;
+    while (n < p.maxIteraciones) {
+        if (z.getReal() * z.getReal() + z.getImag() * z.getImag() > 4.0)
+            break;
+        z = z * z + c;
+        ++n;
     }
-    return sumaTotal;
+    return n;
+}
+
+// -------------------------------
+// Ruta SIMD: CARRILES_FRACTAL píxeles por lazo, sin ramas por carril,
+// para que el compilador use registros vectoriales. Misma fórmula que
+// z * z + c en Complejo.
+// -------------------------------
+void iterarCarriles(const ParametrosFractal& p, const Complejo* puntos, int* salida) {
+    double zr[CARRILES_FRACTAL], zi[CARRILES_FRACTAL];
+    double cr[CARRILES_FRACTAL], ci[CARRILES_FRACTAL];
+    int cuenta[CARRILES_FRACTAL];
+    for (int l = 0; l < CARRILES_FRACTAL; ++l) {
+        zr[l] = p.julia ? puntos[l].getReal() : 0.0;
+        zi[l] = p.julia ? puntos[l].getImag() : 0.0;
+        cr[l] = p.julia ? p.constanteJulia.getReal() : puntos[l].getReal();
+        ci[l] = p.julia ? p.constanteJulia.getImag() : puntos[l].getImag();
+        cuenta[l] = 0;
+    }
+
+    for (int n = 0; n < p.maxIteraciones; ++n) {
+        int activos = 0;
+        for (int l = 0; l < CARRILES_FRACTAL; ++l) {
+            bool vivo = zr[l] * zr[l] + zi[l] * zi[l] <= 4.0;
+            double nuevoR = zr[l] * zr[l] - zi[l] * zi[l] + cr[l];
+            double nuevoI = zr[l] * zi[l] + zi[l] * zr[l] + ci[l];
+            zr[l] = vivo ? nuevoR : zr[l];
+            zi[l] = vivo ? nuevoI : zi[l];
+            cuenta[l] += vivo;
+            activos += vivo;
+        }
+        if (activos == 0)
+            break;
+    }
+
+    for (int l = 0; l < CARRILES_FRACTAL; ++l)
+        salida[l] = cuenta[l];
+}
+
+// -------------------------------
+// Renderiza una tesela [x0, x1) × [y0, y1)
+// -------------------------------
+void renderizarTesela(const ParametrosFractal& p, int x0, int y0, int x1, int y1,
+                      vector<int>& iteraciones) {
+    for (int y = y0; y < y1; ++y) {
+        int x = x0;
+        if (p.simd) {
+            Complejo puntos[CARRILES_FRACTAL];
+            for (; x + CARRILES_FRACTAL <= x1; x += CARRILES_FRACTAL) {
+                for (int l = 0; l < CARRILES_FRACTAL; ++l)
+                    puntos[l] = puntoDePixel(p, x + l, y);
+                iterarCarriles(p, puntos, &iteraciones[(size_t)y * p.ancho + x]);
+            }
+        }
+        for (; x < x1; ++x)
+            iteraciones[(size_t)y * p.ancho + x] = iterarPixel(p, puntoDePixel(p, x, y));
+    }
+}
+
+// -------------------------------
+// Renderiza la imagen completa. Las teselas se reparten dinámicamente
+// (contador atómico), porque el costo por tesela varía mucho.
+// Devuelve las iteraciones por píxel (fila mayor).
+// -------------------------------
+vector<int> renderizarFractal(const ParametrosFractal& p) {
+    vector<int> iteraciones((size_t)p.ancho * p.alto, 0);
+    int teselasX = (p.ancho + p.tamTesela - 1) / p.tamTesela;
+    int teselasY = (p.alto + p.tamTesela - 1) / p.tamTesela;
+    int totalTeselas = teselasX * teselasY;
+
+    unsigned hilos = p.hilos ? p.hilos : max(1u, thread::hardware_concurrency());
+    atomic<int> siguiente(0);
+    auto trabajar = [&] {
+        for (int t = siguiente++; t < totalTeselas; t = siguiente++) {
+            int x0 = (t % teselasX) * p.tamTesela;
+            int y0 = (t / teselasX) * p.tamTesela;
+            renderizarTesela(p, x0, y0, min(x0 + p.tamTesela, p.ancho),
+                             min(y0 + p.tamTesela, p.alto), iteraciones);
+        }
+    };
+
+    vector<thread> grupo;
+    for (unsigned h = 1; h < hilos; ++h)
+        grupo.emplace_back(trabajar);
+    trabajar();
+    for (auto& h : grupo)
+        h.join();
+    return iteraciones;
+}
+
+// -------------------------------
+// Guarda las iteraciones como imagen PGM binaria (P5, 8 bits)
+// -------------------------------
+bool guardarPGM(const string& ruta, const vector<int>& iteraciones,
+                int ancho, int alto, int maxIteraciones) {
+    ofstream archivo(ruta, ios::binary);
+    if (!archivo)
+        return false;
+    archivo << "P5\n" << ancho << " " << alto << "\n255\n";
+
+    vector<unsigned char> gris(iteraciones.size());
+    for (size_t i = 0; i < iteraciones.size(); ++i) {
+        // Puntos del conjunto en negro; el resto con escala logarítmica
+        int n = iteraciones[i];
+        gris[i] = n >= maxIteraciones ? 0
+                : (unsigned char)(255.0 * log1p((double)n) / log1p((double)maxIteraciones));
+    }
+    archivo.write((const char*)gris.data(), (streamsize)gris.size());
+    return (bool)archivo;
+}
+
+// ==================================================
+// Utilidades de benchmark (./eje_4 --bench)
+// ==================================================
+
+// Mejor tiempo (en segundos) de varias repeticiones
+template <typename Funcion>
+double medirSegundos(Funcion funcion, int repeticiones = 3) {
+    double mejor = 1e300;
+    for (int r = 0; r < repeticiones; ++r) {
+        auto t0 = chrono::steady_clock::now();
+        funcion();
+        auto t1 = chrono::steady_clock::now();
+        mejor = min(mejor, chrono::duration<double>(t1 - t0).count());
+    }
+    return mejor;
+}
+
+// Evita que el compilador elimine un resultado no usado
+volatile double sumideroBench = 0;
+
+// -------------------------------
+// Throughput y crecimiento del error de acumular
+// -------------------------------
+void benchAcumular() {
+    cout << "=== BENCH acumular: throughput y error relativo ===\n";
+    cout << "hilos disponibles: " << max(1u, thread::hardware_concurrency()) << "\n";
+    cout << setw(10) << "n" << setw(12) << "modo"
+         << setw(14) << "Melem/s" << setw(14) << "error rel" << "\n";
+
+    mt19937_64 generador(2025);
+    uniform_real_distribution<double> distribucion(0.0, 1.0);
+
+    const char* nombres[] = {"ingenuo", "kahan", "pares"};
+    ModoSuma modos[] = {ModoSuma::Ingenuo, ModoSuma::Kahan, ModoSuma::Pares};
+
+    for (size_t n = 1000; n <= 10000000; n *= 10) {
+        // Valores con magnitudes mezcladas para que el redondeo se note
+        vector<Complejo> datos(n);
+        for (auto& c : datos)
+            c = Complejo(1.0 + distribucion(generador) * 1e-3, 0.1 + distribucion(generador));
+
+        // Referencia en precisión extendida
+        long double refRe = 0, refIm = 0;
+        for (const auto& c : datos) { refRe += c.getReal(); refIm += c.getImag(); }
+
+        for (int m = 0; m < 3; ++m) {
+            Complejo r;
+            double t = medirSegundos([&] { r = acumular(datos, modos[m]); });
+            long double errRe = r.getReal() - refRe, errIm = r.getImag() - refIm;
+            double error = (double)(sqrtl(errRe * errRe + errIm * errIm) /
+                                    sqrtl(refRe * refRe + refIm * refIm));
+            sumideroBench = sumideroBench + r.getReal();
+            cout << setw(10) << n << setw(12) << nombres[m]
+                 << setw(14) << fixed << setprecision(1) << n / t / 1e6
+                 << setw(14) << scientific << setprecision(2) << error << "\n";
+            cout.unsetf(ios::floatfield);
+        }
+    }
+
+    // Determinismo: el resultado debe ser idéntico con cualquier número de hilos
+    vector<Complejo> datos(3000000);
+    for (auto& c : datos)
+        c = Complejo(distribucion(generador) - 0.5, distribucion(generador) * 1e6);
+    Complejo base = acumular(datos, ModoSuma::Kahan, 1);
+    bool identicos = true;
+    for (unsigned h = 2; h <= 16; h *= 2) {
+        Complejo r = acumular(datos, ModoSuma::Kahan, h);
+        identicos = identicos && r.getReal() == base.getReal() && r.getImag() == base.getImag();
+    }
+    cout << "resultado idéntico con 1..16 hilos: " << (identicos ? "sí" : "NO") << "\n\n";
+}
+
+// -------------------------------
+// Distancia en ULP entre un valor aproximado y el de referencia
+// -------------------------------
+double distanciaUlp(double aproximado, double referencia) {
+    if (aproximado == referencia) return 0;
+    double ulp = nextafter(fabs(referencia), INFINITY) - fabs(referencia);
+    return fabs(aproximado - referencia) / ulp;
+}
+
+// -------------------------------
+// Conversión por lotes: escalar vs lote exacto vs lote rápido
+// -------------------------------
+void benchConversion() {
+    cout << "=== BENCH conversión Complejo <-> Polar ===\n";
+    const size_t n = 1 << 22;
+
+    mt19937_64 generador(7);
+    uniform_real_distribution<double> distribucion(-100.0, 100.0);
+    uniform_real_distribution<double> angulos(-50.0, 50.0);
+    vector<Complejo> binomiales(n);
+    vector<Polar> polares(n);
+    for (size_t i = 0; i < n; ++i) {
+        binomiales[i] = Complejo(distribucion(generador), distribucion(generador));
+        polares[i] = Polar(fabs(distribucion(generador)), angulos(generador));
+    }
+
+    vector<Polar> salidaPolar(n), referenciaPolar(n);
+    vector<Complejo> salidaBinomial(n), referenciaBinomial(n);
+
+    double tEscalarP = medirSegundos([&] {
+        for (size_t i = 0; i < n; ++i) referenciaPolar[i] = Polar::desdeBinomial(binomiales[i]);
+    });
+    double tExactaP = medirSegundos([&] {
+        convertirLoteAPolar(binomiales.data(), salidaPolar.data(), n, PrecisionConversion::Exacta);
+    });
+    double tRapidaP = medirSegundos([&] {
+        convertirLoteAPolar(binomiales.data(), salidaPolar.data(), n, PrecisionConversion::Rapida);
+    });
+    double ulpAtan = 0;
+    for (size_t i = 0; i < n; ++i)
+        ulpAtan = max(ulpAtan, distanciaUlp(salidaPolar[i].getAngulo(), referenciaPolar[i].getAngulo()));
+
+    double tEscalarB = medirSegundos([&] {
+        for (size_t i = 0; i < n; ++i) referenciaBinomial[i] = polares[i].convertirABinomial();
+    });
+    double tExactaB = medirSegundos([&] {
+        convertirLoteABinomial(polares.data(), salidaBinomial.data(), n, PrecisionConversion::Exacta);
+    });
+    double tRapidaB = medirSegundos([&] {
+        convertirLoteABinomial(polares.data(), salidaBinomial.data(), n, PrecisionConversion::Rapida);
+    });
+
+    // Error de seno/coseno medido directamente (sin el factor de magnitud)
+    // contra sinl/cosl, en tres muestras: los ángulos del lote, todo el
+    // dominio |θ| ≤ LIMITE_SENO_RAPIDO y ángulos a pocos ULP de kπ/2
+    // (donde la reducción cancela más bits)
+    vector<double> muestraSenCos(n);
+    for (size_t i = 0; i < n; ++i) muestraSenCos[i] = polares[i].getAngulo();
+    uniform_real_distribution<double> dominio(-LIMITE_SENO_RAPIDO, LIMITE_SENO_RAPIDO);
+    uniform_int_distribution<long long> multiplo(-(long long)(LIMITE_SENO_RAPIDO / 1.5707963267948966),
+                                                 (long long)(LIMITE_SENO_RAPIDO / 1.5707963267948966));
+    uniform_int_distribution<int> desplazamiento(-4, 4);
+    for (size_t i = 0; i < n / 2; ++i) {
+        double x = (double)multiplo(generador) * 1.5707963267948966;
+        for (int d = desplazamiento(generador); d != 0; d += d > 0 ? -1 : 1)
+            x = nextafter(x, d > 0 ? INFINITY : -INFINITY);
+        muestraSenCos.push_back(x);
+        muestraSenCos.push_back(dominio(generador));
+    }
+    double absSenCos = 0, ulpSenCos = 0;
+    for (double a : muestraSenCos) {
+        double s, c;
+        senoCosenoRapido(a, s, c);
+        long double sRef = sinl((long double)a), cRef = cosl((long double)a);
+        absSenCos = max(absSenCos, (double)max(fabsl(s - sRef), fabsl(c - cRef)));
+        if (fabsl(sRef) >= 0.5L) ulpSenCos = max(ulpSenCos, distanciaUlp(s, (double)sRef));
+        if (fabsl(cRef) >= 0.5L) ulpSenCos = max(ulpSenCos, distanciaUlp(c, (double)cRef));
+    }
+
+    cout << fixed << setprecision(1);
+    cout << "a polar    : escalar " << n / tEscalarP / 1e6 << " M/s, lote exacto "
+         << n / tExactaP / 1e6 << " M/s, lote rápido " << n / tRapidaP / 1e6
+         << " M/s, máx error atan2 " << ulpAtan << " ULP\n";
+    cout << "a binomial : escalar " << n / tEscalarB / 1e6 << " M/s, lote exacto "
+         << n / tExactaB / 1e6 << " M/s, lote rápido " << n / tRapidaB / 1e6
+         << " M/s\n";
+    cout << "sen/cos rápido en |θ| ≤ " << setprecision(0) << LIMITE_SENO_RAPIDO << " (" << muestraSenCos.size()
+         << " ángulos, incluidos cerca de kπ/2): máx error absoluto " << scientific << setprecision(2)
+         << absSenCos << fixed << setprecision(1) << ", " << ulpSenCos << " ULP donde |valor| ≥ 1/2"
+         << (absSenCos <= COTA_SENO_RAPIDO && ulpSenCos <= 2 ? " (OK)" : " (FALLA)") << "\n\n";
+    cout.unsetf(ios::floatfield);
+}
+
+// -------------------------------
+// Canalización alterna (producto/cociente y suma/resta):
+// binomial puro vs conversión ansiosa vs ComplejoAdaptable
+// -------------------------------
+void benchAdaptable() {
+    cout << "=== BENCH ComplejoAdaptable: conversión perezosa ===\n";
+    const int n = 1 << 20;
+
+    mt19937_64 generador(11);
+    uniform_real_distribution<double> distribucion(0.5, 1.5);
+    vector<Complejo> a(n), b(n), c(n);
+    for (int i = 0; i < n; ++i) {
+        a[i] = Complejo(distribucion(generador), distribucion(generador));
+        b[i] = Complejo(distribucion(generador), distribucion(generador));
+        c[i] = Complejo(distribucion(generador), distribucion(generador));
+    }
+    vector<Polar> pa = convertirLoteAPolar(a);
+
+    // Factores fijos (como los de una FFT) que se reutilizan muchas veces
+    const int TOTAL_FACTORES = 64;
+    vector<Polar> factores(TOTAL_FACTORES);
+    for (int k = 0; k < TOTAL_FACTORES; ++k)
+        factores[k] = Polar(1.0, 2 * acos(-1.0) * k / TOTAL_FACTORES);
+    vector<Complejo> factoresBinomial = convertirLoteABinomial(factores);
+    vector<ComplejoAdaptable> factoresAdaptables(factores.begin(), factores.end());
+
+    // r = (a·w)/c + w, con a y w recibidos en polar y c en binomial
+    Complejo sumaBinomial, sumaAnsiosa, sumaAdaptable;
+    double tBinomial = medirSegundos([&] {
+        sumaBinomial = Complejo();
+        for (int i = 0; i < n; ++i) {
+            const Complejo& w = factoresBinomial[i % TOTAL_FACTORES];
+            sumaBinomial = sumaBinomial + (a[i] * w) / c[i] + w;
+        }
+    });
+    double tAnsiosa = medirSegundos([&] {
+        sumaAnsiosa = Complejo();
+        for (int i = 0; i < n; ++i) {
+            const Polar& w = factores[i % TOTAL_FACTORES];
+            Polar cociente = (pa[i] * w) / Polar::desdeBinomial(c[i]);
+            sumaAnsiosa = sumaAnsiosa + cociente.convertirABinomial() + w.convertirABinomial();
+        }
+    });
+    ComplejoAdaptable::reiniciarEstadisticas();
+    double tAdaptable = medirSegundos([&] {
+        ComplejoAdaptable suma;
+        for (int i = 0; i < n; ++i) {
+            const ComplejoAdaptable& w = factoresAdaptables[i % TOTAL_FACTORES];
+            suma = suma + (ComplejoAdaptable(pa[i]) * w) / ComplejoAdaptable(c[i]) + w;
+        }
+        sumaAdaptable = suma.comoBinomial();
+    }, 1);
+    EstadisticasConversion e = ComplejoAdaptable::estadisticas();
+
+    cout << fixed << setprecision(1);
+    cout << "binomial puro      : " << n / tBinomial / 1e6 << " M/s (a y w ya en binomial)\n";
+    cout << "conversión ansiosa : " << n / tAnsiosa / 1e6 << " M/s, 3 conversiones por elemento\n";
+    cout << "ComplejoAdaptable  : " << n / tAdaptable / 1e6 << " M/s, "
+         << (double)e.realizadas / n << " conversiones y "
+         << (double)e.evitadas / n << " evitadas por elemento\n";
+    cout.unsetf(ios::floatfield);
+    cout << "diferencia relativa adaptable vs ansiosa: "
+         << (sumaAdaptable - sumaAnsiosa).getMagnitud() / sumaAnsiosa.getMagnitud() << "\n\n";
+    sumideroBench = sumideroBench + sumaBinomial.getReal();
+}
+
+// -------------------------------
+// Fractal de referencia: escalar vs SIMD y escalado por hilos
+// -------------------------------
+void benchFractal() {
+    cout << "=== BENCH fractal (Mandelbrot 1024x768, 1000 iteraciones) ===\n";
+    ParametrosFractal p;
+
+    p.simd = false;
+    p.hilos = 1;
+    vector<int> referencia;
+    double tEscalar = medirSegundos([&] { referencia = renderizarFractal(p); }, 1);
+    long long totalIter = 0;
+    for (int n : referencia) totalIter += n;
+
+    cout << fixed << setprecision(1);
+    cout << "escalar, 1 hilo : " << setw(8) << p.ancho * p.alto / tEscalar / 1e6 << " Mpix/s, "
+         << setw(8) << totalIter / tEscalar / 1e6 << " Miter/s\n";
+
+    p.simd = true;
+    unsigned maxHilos = max(1u, thread::hardware_concurrency());
+    for (unsigned h = 1; h <= maxHilos; h *= 2) {
+        p.hilos = h;
+        vector<int> r;
+        double t = medirSegundos([&] { r = renderizarFractal(p); }, 1);
+        size_t distintos = 0;
+        for (size_t i = 0; i < r.size(); ++i) distintos += r[i] != referencia[i];
+        cout << "simd, " << setw(2) << h << " hilos  : " << setw(8) << p.ancho * p.alto / t / 1e6
+             << " Mpix/s, " << setw(8) << totalIter / t / 1e6 << " Miter/s, píxeles distintos: "
+             << distintos << "\n";
+    }
+    cout.unsetf(ios::floatfield);
+    cout << "suma de iteraciones (control de regresión): " << totalIter << "\n\n";
+}
+
+// -------------------------------
+// División por un divisor fijo: operator/ vs Smith vs recíproco en lote
+// -------------------------------
+void benchDivision() {
+    cout << "=== BENCH división por un complejo fijo ===\n";
+    // Arreglo que cabe en caché, dividido en el lugar muchas veces: mide
+    // cómputo y no memoria. Cada pasada usa un divisor unitario distinto
+    // y depende de la anterior, así ninguna pasada se puede omitir.
+    const size_t n = 1 << 12;
+    const int pasadas = 1000;
+
+    mt19937_64 generador(13);
+    uniform_real_distribution<double> distribucion(-10.0, 10.0);
+    vector<Complejo> datos(n);
+    for (auto& c : datos)
+        c = Complejo(distribucion(generador), distribucion(generador));
+    vector<Complejo> divisores(pasadas);
+    for (int k = 0; k < pasadas; ++k)
+        divisores[k] = Complejo(cos(0.001 * k), sin(0.001 * k));
+
+    vector<Complejo> referencia, salida;
+    double tOperador = medirSegundos([&] {
+        referencia = datos;
+        for (int k = 0; k < pasadas; ++k)
+            for (size_t i = 0; i < n; ++i) referencia[i] = referencia[i] / divisores[k];
+    });
+    double tSmith = medirSegundos([&] {
+        salida = datos;
+        for (int k = 0; k < pasadas; ++k)
+            for (size_t i = 0; i < n; ++i) salida[i] = salida[i].dividirSmith(divisores[k]);
+    });
+    double tLote = medirSegundos([&] {
+        salida = datos;
+        for (int k = 0; k < pasadas; ++k)
+            dividirLote(salida.data(), salida.data(), n, divisores[k]);
+    });
+
+    double errorMax = 0;
+    for (size_t i = 0; i < n; ++i)
+        errorMax = max(errorMax, (salida[i] - referencia[i]).getMagnitud() / referencia[i].getMagnitud());
+
+    cout << fixed << setprecision(1);
+    double total = (double)n * pasadas;
+    cout << "operator/     : " << setw(8) << total / tOperador / 1e6 << " M/s\n";
+    cout << "dividirSmith  : " << setw(8) << total / tSmith / 1e6 << " M/s\n";
+    cout << "dividirLote   : " << setw(8) << total / tLote / 1e6 << " M/s\n";
+    cout.unsetf(ios::floatfield);
+    cout << "máx diferencia relativa lote vs operator/ tras " << pasadas << " pasadas: " << errorMax << "\n";
+
+    // Rango extremo: c² + d² desborda o se anula en operator/
+    Complejo grande(1e200, 1e200), chico(1e-200, 1e-200);
+    cout << "(1e200+1e200i)/(1e200+1e200i): operator/ = ";
+    (grande / grande).mostrar();
+    cout << ", Smith = ";
+    grande.dividirSmith(grande).mostrar();
+    cout << ", recíproco = ";
+    (grande / ReciprocoComplejo(grande)).mostrar();
+    cout << "\n(1e-200+1e-200i)/(1e-200+1e-200i): operator/ = ";
+    (chico / chico).mostrar();
+    cout << ", Smith = ";
+    chico.dividirSmith(chico).mostrar();
+    cout << ", recíproco = ";
+    (chico / ReciprocoComplejo(chico)).mostrar();
+    cout << "\n\n";
 }
 
 // ==================================================
 // Función principal
 // ==================================================
-int main() {
+int main(int argc, char* argv[]) {
+    // Modo benchmark: ./eje_4 --bench
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        benchAcumular();
+        benchConversion();
+        benchAdaptable();
+        benchFractal();
+        benchDivision();
+        return 0;
+    }
+
+    // Fractal a archivo: ./eje_4 --fractal salida.pgm [julia]
+    if (argc > 2 && string(argv[1]) == "--fractal") {
+        ParametrosFractal p;
+        if (argc > 3 && string(argv[3]) == "julia") {
+            p.julia = true;
+            p.centroReal = 0.0;
+        }
+        vector<int> iteraciones = renderizarFractal(p);
+        if (!guardarPGM(argv[2], iteraciones, p.ancho, p.alto, p.maxIteraciones)) {
+            cout << "No se pudo escribir " << argv[2] << endl;
+            return 1;
+        }
+        cout << "Imagen guardada en " << argv[2] << endl;
+        return 0;
+    }
+
     system("chcp 65001 > nul");  // Activa UTF-8 en consola (Windows)
 
     // Creación de números complejos
@@ -4,6 +4,30 @@
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <random>
+#include <chrono>
+#include <queue>
+#include <climits>
+#include <thread>
+#include <charconv>
+#include <cstring>
+#include <cmath>
+#include <string_view>
+#include <fstream>
+#include <cstdio>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#if defined(_WIN32) || defined(_WIN64)
+    #include <io.h>
+    #define escribirBytes _write
+#else
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #define escribirBytes write
+#endif
 using namespace std;
 
 // ===================================================
@@ -34,35 +58,52 @@ public:
     int leerExp() const { return gradoExp; }
 
     // ------------------------------------------------
-    // Convierte el término en texto con formato algebraico (+4x^3)
+    // Longitud máxima del texto de un término: signo, coeficiente en
+    // formato %g de 6 cifras (p. ej. 1.23457e-308), "x^" y el exponente
     // ------------------------------------------------
-    string aTexto() const {
-        stringstream salidaTxt;
+    static const size_t MAX_TEXTO = 40;
 
+    // ------------------------------------------------
+    // Escribe el término en 'destino' (al menos MAX_TEXTO bytes) con el
+    // mismo formato que aTexto() y devuelve cuántos bytes usó.
+    // El coeficiente sale como lo haría un stringstream por defecto
+    // (precisión 6, formato general), pero sin crear ningún flujo.
+    // ------------------------------------------------
+    size_t escribirTexto(char* destino) const {
         if (valorCoef == 0)
-            return "";
+            return 0;
+
+        char* p = destino;
+        char* fin = destino + MAX_TEXTO;
 
         // Determina el signo que se mostrará
-        if (valorCoef > 0)
-            salidaTxt << "+";
-        else
-            salidaTxt << "-";
+        *p++ = valorCoef > 0 ? '+' : '-';
 
         // Valor absoluto del coeficiente
-        double valorAbs = abs(valorCoef);
+        double valorAbs = fabs(valorCoef);
 
         // Muestra el número si no es 1 o si el exponente es 0
         if (valorAbs != 1 || gradoExp == 0)
-            salidaTxt << valorAbs;
+            p = to_chars(p, fin, valorAbs, chars_format::general, 6).ptr;
 
         // Agrega la parte literal con x y su exponente
         if (gradoExp > 0) {
-            salidaTxt << "x";
-            if (gradoExp > 1)
-                salidaTxt << "^" << gradoExp;
+            *p++ = 'x';
+            if (gradoExp > 1) {
+                *p++ = '^';
+                p = to_chars(p, fin, gradoExp).ptr;
+            }
         }
 
-        return salidaTxt.str();
+        return p - destino;
+    }
+
+    // ------------------------------------------------
+    // Convierte el término en texto con formato algebraico (+4x^3)
+    // ------------------------------------------------
+    string aTexto() const {
+        char bufer[MAX_TEXTO];
+        return string(bufer, escribirTexto(bufer));
     }
 
     // ------------------------------------------------
@@ -88,12 +129,861 @@ public:
     }
 };
 
+// ===================================================
+// Copia el texto de un término separando cada signo con espacios
+// (" + ", " - "). En el primer término del polinomio se omite el '+'
+// inicial. 'destino' necesita hasta 3 bytes por cada byte del término.
+// ===================================================
+inline char* copiarConSignosEspaciados(const char* termino, size_t largo, char* destino, bool& primero) {
+    size_t i = 0;
+    if (primero && largo > 0) {
+        if (termino[0] == '+')
+            i = 1; // Elimina el '+' inicial
+        primero = false;
+    }
+    for (; i < largo; ++i) {
+        char c = termino[i];
+        if (c == '+' || c == '-') {
+            destino[0] = ' ';
+            destino[1] = c;
+            destino[2] = ' ';
+            destino += 3;
+        } else {
+            *destino++ = c;
+        }
+    }
+    return destino;
+}
+
+// ===================================================
+// Núcleos de multiplicación dispersa sobre listas ordenadas de términos.
+// 'filas' y 'columnas' vienen ordenadas por exponente creciente; solo se
+// generan los productos con exponente en [desde, hasta), de modo que el
+// trabajo se puede repartir por rangos del resultado. En ambos núcleos
+// los aportes a un mismo exponente se suman en orden creciente de fila,
+// por eso dan exactamente los mismos coeficientes.
+// ===================================================
+
+// Modo de multiplicación de CPolinomio
+enum class ModoMultiplicacion {
+    Automatico,  // Elige según la densidad de exponentes del resultado
+    Heap,        // Fusión con montículo de Johnson, memoria O(filas)
+    Hash         // Acumulador en tabla hash indexada por exponente
+};
+
+// Tamaño máximo de la tabla del acumulador hash (entradas)
+const long long LIMITE_TABLA_HASH = 1LL << 24;
+
+// ------------------------------------------------
+// Primer índice de 'columnas' cuyo exponente sumado a 'base' llega a 'objetivo'
+// ------------------------------------------------
+size_t primeraColumnaDesde(const vector<CTermino>& columnas, long long base, long long objetivo) {
+    return lower_bound(columnas.begin(), columnas.end(), objetivo,
+                       [base](const CTermino& t, long long valor) {
+                           return base + t.leerExp() < valor;
+                       }) - columnas.begin();
+}
+
+// ------------------------------------------------
+// Cantidad de productos con exponente en [desde, hasta)
+// ------------------------------------------------
+long long contarProductos(const vector<CTermino>& filas, const vector<CTermino>& columnas,
+                          long long desde, long long hasta) {
+    long long total = 0;
+    for (const auto& f : filas)
+        total += (long long)primeraColumnaDesde(columnas, f.leerExp(), hasta) -
+                 (long long)primeraColumnaDesde(columnas, f.leerExp(), desde);
+    return total;
+}
+
+// ------------------------------------------------
+// Fusión de Johnson: un cursor por fila dentro de un montículo mínimo.
+// Produce los términos ya ordenados por exponente. O(P log filas).
+// ------------------------------------------------
+void multiplicarConHeap(const vector<CTermino>& filas, const vector<CTermino>& columnas,
+                        long long desde, long long hasta, vector<CTermino>& salida) {
+    struct Cursor {
+        long long exponente;
+        unsigned fila, columna;
+    };
+    // Orden del montículo: exponente y, en empate, fila
+    auto menor = [](const Cursor& x, const Cursor& y) {
+        return x.exponente != y.exponente ? x.exponente < y.exponente : x.fila < y.fila;
+    };
+
+    vector<Cursor> monticulo;
+    monticulo.reserve(filas.size());
+    for (size_t i = 0; i < filas.size(); ++i) {
+        size_t j = primeraColumnaDesde(columnas, filas[i].leerExp(), desde);
+        if (j < columnas.size() && filas[i].leerExp() + (long long)columnas[j].leerExp() < hasta)
+            monticulo.push_back({filas[i].leerExp() + (long long)columnas[j].leerExp(),
+                                 (unsigned)i, (unsigned)j});
+    }
+    // Los cursores iniciales ya están ordenados por fila y exponente
+    // creciente en cada fila, pero no entre filas: se arma el montículo
+    auto hundir = [&](size_t k) {
+        Cursor c = monticulo[k];
+        size_t n = monticulo.size();
+        while (true) {
+            size_t hijo = 2 * k + 1;
+            if (hijo >= n) break;
+            if (hijo + 1 < n && menor(monticulo[hijo + 1], monticulo[hijo])) ++hijo;
+            if (!menor(monticulo[hijo], c)) break;
+            monticulo[k] = monticulo[hijo];
+            k = hijo;
+        }
+        monticulo[k] = c;
+    };
+    for (size_t k = monticulo.size() / 2; k-- > 0;)
+        hundir(k);
+
+    while (!monticulo.empty()) {
+        long long exponente = monticulo[0].exponente;
+        double coeficiente = 0;
+        while (!monticulo.empty() && monticulo[0].exponente == exponente) {
+            Cursor& c = monticulo[0];
+            coeficiente += filas[c.fila].leerCoef() * columnas[c.columna].leerCoef();
+            // El cursor avanza en su fila y se reemplaza en la cima
+            if (++c.columna < columnas.size() &&
+                (c.exponente = filas[c.fila].leerExp() + (long long)columnas[c.columna].leerExp()) < hasta) {
+                hundir(0);
+            } else {
+                monticulo[0] = monticulo.back();
+                monticulo.pop_back();
+                if (!monticulo.empty()) hundir(0);
+            }
+        }
+        if (coeficiente != 0)
+            salida.emplace_back(coeficiente, (int)exponente);
+    }
+}
+
+// ------------------------------------------------
+// Acumulador hash: cada producto se suma en una tabla indexada por
+// exponente. Si la tabla cubre todo el rango es un arreglo directo (ya
+// ordenado); si no, usa sondeo lineal y se ordena al final. O(P + k log k).
+// Si los exponentes distintos posibles no caben en 'limiteTabla' con
+// sondeo lineal, la tabla se llenaría: en ese caso se usa el heap, que da
+// los mismos coeficientes.
+// ------------------------------------------------
+void multiplicarConHash(const vector<CTermino>& filas, const vector<CTermino>& columnas,
+                        long long desde, long long hasta, vector<CTermino>& salida,
+                        long long limiteTabla = LIMITE_TABLA_HASH) {
+    long long productos = contarProductos(filas, columnas, desde, hasta);
+    if (productos == 0)
+        return;
+    long long rango = hasta - desde;
+    long long distintosMax = min(rango, productos);
+    if (rango > limiteTabla && 2 * distintosMax > limiteTabla) {
+        multiplicarConHeap(filas, columnas, desde, hasta, salida);
+        return;
+    }
+    size_t capacidad = 1;
+    while ((long long)capacidad < min(2 * distintosMax, limiteTabla)) capacidad <<= 1;
+    if ((long long)capacidad >= rango / 2 && (long long)capacidad < rango && rango <= limiteTabla)
+        capacidad <<= 1;
+    bool directa = (long long)capacidad >= rango;
+    size_t mascara = capacidad - 1;
+
+    const long long VACIA = LLONG_MIN;
+    vector<long long> claves(capacidad, VACIA);
+    vector<double> valores(capacidad, 0.0);
+
+    for (const auto& f : filas) {
+        size_t j = primeraColumnaDesde(columnas, f.leerExp(), desde);
+        size_t fin = primeraColumnaDesde(columnas, f.leerExp(), hasta);
+        for (; j < fin; ++j) {
+            long long exponente = f.leerExp() + (long long)columnas[j].leerExp();
+            size_t posicion = directa ? (size_t)(exponente - desde)
+                                      : (size_t)(((unsigned long long)exponente * 0x9E3779B97F4A7C15ULL) >> 20) & mascara;
+            while (claves[posicion] != VACIA && claves[posicion] != exponente)
+                posicion = (posicion + 1) & mascara;
+            claves[posicion] = exponente;
+            valores[posicion] += f.leerCoef() * columnas[j].leerCoef();
+        }
+    }
+
+    size_t inicio = salida.size();
+    for (size_t p = 0; p < capacidad; ++p)
+        if (claves[p] != VACIA && valores[p] != 0)
+            salida.emplace_back(valores[p], (int)claves[p]);
+    if (!directa)
+        sort(salida.begin() + inicio, salida.end(),
+             [](const CTermino& a, const CTermino& b) { return a.leerExp() < b.leerExp(); });
+}
+
+// ------------------------------------------------
+// Elige el núcleo: hash si el resultado es denso en exponentes (muchos
+// productos caen en el mismo exponente) y la tabla cabe; si no, heap
+// ------------------------------------------------
+ModoMultiplicacion elegirModo(const vector<CTermino>& filas, const vector<CTermino>& columnas) {
+    if (filas.empty() || columnas.empty())
+        return ModoMultiplicacion::Heap;
+    long long rango = (long long)filas.back().leerExp() + columnas.back().leerExp()
+                    - filas.front().leerExp() - columnas.front().leerExp() + 1;
+    long long productos = (long long)filas.size() * (long long)columnas.size();
+    if (rango <= 2 * productos && rango <= LIMITE_TABLA_HASH)
+        return ModoMultiplicacion::Hash;
+    return ModoMultiplicacion::Heap;
+}
+
+// ===================================================
+// Núcleos para la representación densa (coeficientes contiguos).
+// 'salida' ya viene en cero y cubre todo el rango del producto. Los
+// aportes a cada exponente se suman en orden creciente de fila, igual
+// que en los núcleos dispersos, así el resultado es el mismo; las filas
+// nulas se saltan (sumar cero no cambia nada). Los bucles internos son
+// del tipo y += c·x y el compilador los vectoriza.
+// ===================================================
+
+// Fracción de ocupación desde la cual un polinomio pasa a denso, y bajo
+// la cual vuelve a disperso (la diferencia evita cambios de ida y vuelta)
+const double FRACCION_DENSA = 0.5;
+const double FRACCION_DISPERSA = 0.25;
+
+// ------------------------------------------------
+// Denso × denso: filas a[0..nA), columnas b[0..nB)
+// ------------------------------------------------
+void multiplicarDensos(const double* a, size_t nA, const double* b, size_t nB, double* salida) {
+    for (size_t i = 0; i < nA; ++i) {
+        double c = a[i];
+        if (c == 0) continue;
+        double* s = salida + i;
+        for (size_t j = 0; j < nB; ++j)
+            s[j] += c * b[j];
+    }
+}
+
+// ------------------------------------------------
+// Disperso × denso: cada término de las filas suma una copia escalada
+// de las columnas en 'salida + desplazamiento'
+// ------------------------------------------------
+void multiplicarDispersoPorDenso(const vector<CTermino>& filas, const double* b, size_t nB,
+                                 long long desplazamiento, double* salida) {
+    for (const auto& t : filas) {
+        double c = t.leerCoef();
+        double* s = salida + (t.leerExp() + desplazamiento);
+        for (size_t j = 0; j < nB; ++j)
+            s[j] += c * b[j];
+    }
+}
+
+// ------------------------------------------------
+// Denso × disperso: cada fila densa reparte sus productos en los
+// exponentes de las columnas
+// ------------------------------------------------
+void multiplicarDensoPorDisperso(const double* a, size_t nA, const vector<CTermino>& columnas,
+                                 long long desplazamiento, double* salida) {
+    for (size_t i = 0; i < nA; ++i) {
+        double c = a[i];
+        if (c == 0) continue;
+        double* s = salida + (i + desplazamiento);
+        for (const auto& t : columnas)
+            s[t.leerExp()] += c * t.leerCoef();
+    }
+}
+
+// ===================================================
+// Núcleos de división con resto. Se divide 'f' entre 'g' (términos en
+// orden creciente, g no nulo); un término pasa al cociente mientras su
+// exponente sea al menos el exponente principal de g. En los tres
+// núcleos cada coeficiente del resto parcial resta los productos en el
+// orden en que se crearon los términos del cociente.
+// ===================================================
+
+// Modo de división de CPolinomio
+enum class ModoDivision {
+    Automatico,  // Según la representación y el tamaño de los operandos
+    Dispersa,    // Montículo sobre los términos del cociente
+    Densa,       // División larga sobre arreglos de coeficientes
+    Newton       // Recíproco por iteración de Newton y productos Karatsuba
+};
+
+// Tamaño mínimo (cociente y divisor) para preferir la vía de Newton
+const size_t UMBRAL_NEWTON = 2048;
+
+// Tamaño bajo el cual Karatsuba usa el producto directo
+const size_t UMBRAL_KARATSUBA = 48;
+
+// ------------------------------------------------
+// División dispersa: los términos del resto parcial se generan en orden
+// decreciente de exponente; un montículo guarda, por cada término del
+// cociente, el siguiente producto q_i · g_j que falta restar.
+// O(|q|·|g|·log |q|), sin recorrer los exponentes vacíos.
+// ------------------------------------------------
+void dividirConHeap(const vector<CTermino>& f, const vector<CTermino>& g,
+                    vector<CTermino>& cociente, vector<CTermino>& residuo) {
+    const CTermino& principal = g.back();
+    vector<CTermino> q;  // Cociente en orden decreciente
+    vector<CTermino> r;  // Resto en orden decreciente
+
+    struct Cursor {
+        long long exponente;
+        unsigned termino;  // Índice en q
+        unsigned columna;  // Índice en g contado desde el final
+    };
+    auto antes = [](const Cursor& x, const Cursor& y) {
+        return x.exponente != y.exponente ? x.exponente > y.exponente : x.termino < y.termino;
+    };
+    vector<Cursor> monticulo;
+    auto hundir = [&](size_t k) {
+        Cursor c = monticulo[k];
+        size_t n = monticulo.size();
+        while (true) {
+            size_t hijo = 2 * k + 1;
+            if (hijo >= n) break;
+            if (hijo + 1 < n && antes(monticulo[hijo + 1], monticulo[hijo])) ++hijo;
+            if (!antes(monticulo[hijo], c)) break;
+            monticulo[k] = monticulo[hijo];
+            k = hijo;
+        }
+        monticulo[k] = c;
+    };
+    auto subir = [&](size_t k) {
+        Cursor c = monticulo[k];
+        while (k > 0 && antes(c, monticulo[(k - 1) / 2])) {
+            monticulo[k] = monticulo[(k - 1) / 2];
+            k = (k - 1) / 2;
+        }
+        monticulo[k] = c;
+    };
+
+    size_t i = f.size();
+    while (i > 0 || !monticulo.empty()) {
+        long long exponente = LLONG_MIN;
+        if (i > 0) exponente = f[i - 1].leerExp();
+        if (!monticulo.empty()) exponente = max(exponente, monticulo[0].exponente);
+
+        double coeficiente = 0;
+        if (i > 0 && f[i - 1].leerExp() == exponente)
+            coeficiente = f[--i].leerCoef();
+        while (!monticulo.empty() && monticulo[0].exponente == exponente) {
+            Cursor& c = monticulo[0];
+            coeficiente -= q[c.termino].leerCoef() * g[g.size() - 1 - c.columna].leerCoef();
+            if (++c.columna < g.size()) {
+                c.exponente = (long long)q[c.termino].leerExp() + g[g.size() - 1 - c.columna].leerExp();
+                hundir(0);
+            } else {
+                monticulo[0] = monticulo.back();
+                monticulo.pop_back();
+                if (!monticulo.empty()) hundir(0);
+            }
+        }
+        if (coeficiente == 0)
+            continue;
+        if (exponente >= principal.leerExp()) {
+            q.emplace_back(coeficiente / principal.leerCoef(), (int)(exponente - principal.leerExp()));
+            if (g.size() > 1) {
+                monticulo.push_back({(long long)q.back().leerExp() + g[g.size() - 2].leerExp(),
+                                     (unsigned)(q.size() - 1), 1});
+                subir(monticulo.size() - 1);
+            }
+        } else {
+            r.emplace_back(coeficiente, (int)exponente);
+        }
+    }
+    cociente.assign(q.rbegin(), q.rend());
+    residuo.assign(r.rbegin(), r.rend());
+}
+
+// ------------------------------------------------
+// División larga densa, en el lugar: 'resto' trae f con el exponente
+// 'base' en la posición 0 y g viene como arreglo desde el exponente
+// baseG (su último coeficiente es el principal). Escribe el cociente en
+// 'cociente' (exponentes 0 .. tamaño-1) y deja el resto en 'resto'.
+// Cada paso es un y -= c·x sobre el divisor, que se vectoriza.
+// ------------------------------------------------
+void dividirDenso(vector<double>& resto, long long base, const double* g, size_t nG, long long baseG,
+                  vector<double>& cociente) {
+    long long principal = baseG + (long long)nG - 1;
+    long long mayor = base + (long long)resto.size() - 1;
+    cociente.assign(mayor >= principal ? (size_t)(mayor - principal + 1) : 0, 0.0);
+    double lider = g[nG - 1];
+    for (long long e = mayor; e >= principal; --e) {
+        double c = resto[e - base];
+        if (c == 0) continue;
+        double factor = c / lider;
+        cociente[e - principal] = factor;
+        double* r = resto.data() + (e - principal + baseG - base);
+        for (size_t k = 0; k + 1 < nG; ++k)
+            r[k] -= factor * g[k];
+        resto[e - base] = 0;
+    }
+}
+
+// ------------------------------------------------
+// Karatsuba para dos arreglos del mismo largo n; suma a·b en
+// salida[0 .. 2n-1)
+// ------------------------------------------------
+void acumularKaratsuba(const double* a, const double* b, size_t n, double* salida) {
+    if (n <= UMBRAL_KARATSUBA) {
+        multiplicarDensos(a, n, b, n, salida);
+        return;
+    }
+    size_t mitad = n / 2, alto = n - mitad;
+    vector<double> sumaA(alto), sumaB(alto);
+    for (size_t k = 0; k < alto; ++k) {
+        sumaA[k] = a[mitad + k] + (k < mitad ? a[k] : 0.0);
+        sumaB[k] = b[mitad + k] + (k < mitad ? b[k] : 0.0);
+    }
+    vector<double> bajo(2 * mitad - 1, 0.0), altoProd(2 * alto - 1, 0.0), medio(2 * alto - 1, 0.0);
+    acumularKaratsuba(a, b, mitad, bajo.data());
+    acumularKaratsuba(a + mitad, b + mitad, alto, altoProd.data());
+    acumularKaratsuba(sumaA.data(), sumaB.data(), alto, medio.data());
+    for (size_t k = 0; k < bajo.size(); ++k) {
+        salida[k] += bajo[k];
+        medio[k] -= bajo[k];
+    }
+    for (size_t k = 0; k < altoProd.size(); ++k) {
+        salida[2 * mitad + k] += altoProd[k];
+        medio[k] -= altoProd[k];
+    }
+    for (size_t k = 0; k < medio.size(); ++k)
+        salida[mitad + k] += medio[k];
+}
+
+// ------------------------------------------------
+// Producto de arreglos de cualquier largo: el más largo se corta en
+// bloques del largo del más corto y cada bloque usa Karatsuba
+// ------------------------------------------------
+vector<double> productoKaratsuba(const vector<double>& a, const vector<double>& b) {
+    if (a.empty() || b.empty())
+        return {};
+    const vector<double>& corto = a.size() <= b.size() ? a : b;
+    const vector<double>& largo = a.size() <= b.size() ? b : a;
+    size_t n = corto.size();
+    vector<double> salida(a.size() + b.size() - 1, 0.0);
+    vector<double> bloque(n), parcial(2 * n - 1);
+    for (size_t inicio = 0; inicio < largo.size(); inicio += n) {
+        size_t tam = min(n, largo.size() - inicio);
+        copy(largo.begin() + inicio, largo.begin() + inicio + tam, bloque.begin());
+        fill(bloque.begin() + tam, bloque.end(), 0.0);
+        fill(parcial.begin(), parcial.end(), 0.0);
+        acumularKaratsuba(bloque.data(), corto.data(), n, parcial.data());
+        size_t utiles = min(parcial.size(), salida.size() - inicio);
+        for (size_t k = 0; k < utiles; ++k)
+            salida[inicio + k] += parcial[k];
+    }
+    return salida;
+}
+
+// ------------------------------------------------
+// Inverso de una serie de potencias módulo x^n por iteración de Newton:
+// h ← h·(2 − s·h), duplicando la precisión en cada paso (s[0] != 0)
+// ------------------------------------------------
+vector<double> inversoSerie(const vector<double>& serie, size_t n) {
+    vector<double> h = {1.0 / serie[0]};
+    size_t precision = 1;
+    while (precision < n) {
+        precision = min(2 * precision, n);
+        vector<double> s(serie.begin(), serie.begin() + min(precision, serie.size()));
+        vector<double> error = productoKaratsuba(s, h);
+        error.resize(precision, 0.0);
+        for (double& e : error) e = -e;
+        error[0] += 2.0;
+        h = productoKaratsuba(h, error);
+        h.resize(precision, 0.0);
+    }
+    return h;
+}
+
+// ------------------------------------------------
+// División por el recíproco (misma convención que dividirDenso):
+// con k = grado del cociente + 1 y los polinomios invertidos,
+// rev(q) = rev(f) · rev(g)^-1 mod x^k; luego resto = f − q·g.
+// Con Karatsuba cuesta O(n^1.59) en lugar de O(|q|·|g|).
+// ------------------------------------------------
+void dividirNewton(vector<double>& resto, long long base, const double* g, size_t nG, long long baseG,
+                   vector<double>& cociente) {
+    long long principal = baseG + (long long)nG - 1;
+    long long mayor = base + (long long)resto.size() - 1;
+    if (mayor < principal) {
+        cociente.clear();
+        return;
+    }
+    size_t k = (size_t)(mayor - principal + 1);
+    vector<double> fInvertido(k, 0.0), gInvertido(min(k, nG), 0.0);
+    for (size_t j = 0; j < k; ++j)
+        fInvertido[j] = resto[resto.size() - 1 - j];
+    for (size_t j = 0; j < gInvertido.size(); ++j)
+        gInvertido[j] = g[nG - 1 - j];
+
+    vector<double> qInvertido = productoKaratsuba(fInvertido, inversoSerie(gInvertido, k));
+    cociente.assign(k, 0.0);
+    for (size_t j = 0; j < k; ++j)
+        cociente[k - 1 - j] = qInvertido[j];
+
+    // resto = f − q·g, conservando solo los exponentes menores que el principal
+    vector<double> producto = productoKaratsuba(cociente, vector<double>(g, g + nG));
+    long long baseProducto = baseG;  // q empieza en el exponente 0
+    for (size_t j = 0; j < producto.size(); ++j)
+        resto[baseProducto + (long long)j - base] -= producto[j];
+    for (long long e = principal; e <= mayor; ++e)
+        resto[e - base] = 0;
+}
+
+// ===================================================
+// Aritmética modular para el MCD de polinomios con coeficientes enteros.
+// Se calcula el MCD módulo varios primos de 30 bits y se reconstruyen
+// los coeficientes enteros por el teorema chino del resto; así nunca se
+// acumula error de redondeo ni crecen los coeficientes intermedios.
+// El candidato se acepta solo si divide exactamente a ambos polinomios.
+// ===================================================
+const uint32_t PRIMOS_MCD[] = {1073741789, 1073741783, 1073741741, 1073741723,
+                               1073741719, 1073741717, 1073741689, 1073741671,
+                               1073741663, 1073741651, 1073741621, 1073741567};
+
+// Mayor entero que un double representa sin redondeo (2^53)
+const double LIMITE_ENTERO_EXACTO = 9007199254740992.0;
+
+inline uint32_t multiplicarModulo(uint32_t a, uint32_t b, uint32_t p) {
+    return (uint32_t)((uint64_t)a * b % p);
+}
+
+inline uint32_t potenciaModulo(uint32_t base, uint64_t e, uint32_t p) {
+    uint32_t resultado = 1;
+    while (e > 0) {
+        if (e & 1) resultado = multiplicarModulo(resultado, base, p);
+        base = multiplicarModulo(base, base, p);
+        e >>= 1;
+    }
+    return resultado;
+}
+
+// Inverso por el pequeño teorema de Fermat (p primo, a != 0)
+inline uint32_t inversoModulo(uint32_t a, uint32_t p) { return potenciaModulo(a, p - 2, p); }
+
+inline uint32_t reducirModulo(long long valor, uint32_t p) {
+    long long r = valor % (long long)p;
+    return (uint32_t)(r < 0 ? r + p : r);
+}
+
+// ------------------------------------------------
+// Resto de a entre b módulo p, en el lugar (coeficientes del exponente
+// 0 en adelante, sin ceros al final; b no vacío)
+// ------------------------------------------------
+void restoModulo(vector<uint32_t>& a, const vector<uint32_t>& b, uint32_t p) {
+    uint32_t inverso = inversoModulo(b.back(), p);
+    size_t nB = b.size();
+    while (a.size() >= nB) {
+        uint32_t factor = multiplicarModulo(a.back(), inverso, p);
+        size_t desplazamiento = a.size() - nB;
+        if (factor != 0)
+            for (size_t k = 0; k < nB; ++k)
+                a[desplazamiento + k] = (uint32_t)((a[desplazamiento + k] + (uint64_t)(p - multiplicarModulo(factor, b[k], p))) % p);
+        a.pop_back();
+        while (!a.empty() && a.back() == 0) a.pop_back();
+    }
+}
+
+// ------------------------------------------------
+// MCD mónico módulo p por el algoritmo de Euclides
+// ------------------------------------------------
+vector<uint32_t> mcdModulo(vector<uint32_t> a, vector<uint32_t> b, uint32_t p) {
+    while (!b.empty()) {
+        restoModulo(a, b, p);
+        swap(a, b);
+    }
+    if (!a.empty()) {
+        uint32_t inverso = inversoModulo(a.back(), p);
+        for (auto& c : a) c = multiplicarModulo(c, inverso, p);
+    }
+    return a;
+}
+
+// El teorema chino del resto y la comprobación del candidato trabajan con
+// enteros de 128 bits: con cuatro primos de 30 bits el módulo llega a
+// 2^120, suficiente para los coeficientes escalados por gamma (hasta
+// 2^106) de un MCD que quepa en un double. Sin __int128 mcdModular no se
+// usa y mcd() recurre a Euclides en punto flotante.
+#if defined(__SIZEOF_INT128__)
+    #define MCD_MODULAR_DISPONIBLE 1
+    typedef unsigned __int128 NaturalAmplio;
+    typedef __int128 EnteroAmplio;
+    const size_t MAX_PRIMOS_CRT = 4;
+
+    inline NaturalAmplio mcdAmplio(NaturalAmplio a, NaturalAmplio b) {
+        while (b != 0) {
+            NaturalAmplio r = a % b;
+            a = b;
+            b = r;
+        }
+        return a;
+    }
+
+    // ------------------------------------------------
+    // Indica si g divide exactamente a sobre los enteros (coeficientes
+    // desde el exponente 0, g no vacío). Si un cociente o un resto
+    // intermedio se sale del rango seguro de 128 bits, no se puede
+    // asegurar y devuelve false.
+    // ------------------------------------------------
+    bool divideExactamente(const vector<long long>& a, const vector<long long>& g) {
+        const EnteroAmplio LIMITE_COCIENTE = (EnteroAmplio)1 << 70;
+        const EnteroAmplio LIMITE_RESTO = (EnteroAmplio)1 << 124;
+        vector<EnteroAmplio> resto(a.begin(), a.end());
+        size_t nG = g.size();
+        while (resto.size() >= nG) {
+            EnteroAmplio lider = resto.back();
+            if (lider != 0) {
+                if (lider % g.back() != 0)
+                    return false;
+                EnteroAmplio q = lider / g.back();
+                if (q > LIMITE_COCIENTE || q < -LIMITE_COCIENTE)
+                    return false;
+                size_t desplazamiento = resto.size() - nG;
+                for (size_t k = 0; k < nG; ++k) {
+                    EnteroAmplio& r = resto[desplazamiento + k];
+                    r -= q * g[k];
+                    if (r > LIMITE_RESTO || r < -LIMITE_RESTO)
+                        return false;
+                }
+            }
+            resto.pop_back();
+        }
+        for (EnteroAmplio r : resto)
+            if (r != 0) return false;
+        return true;
+    }
+#endif
+
+// ===================================================
+// Evaluación de polinomios dispersos
+// Se recorren los términos en orden de exponente y la potencia actual
+// avanza de un exponente al siguiente elevando x al salto por cuadrados
+// sucesivos: O(términos · log salto) en vez de O(grado máximo), así
+// x^100000 + 1 cuesta unas 17 multiplicaciones.
+// ===================================================
+
+// Puntos que se evalúan a la vez en evaluarLote (un vector SIMD o dos)
+const int CARRILES_EVALUACION = 8;
+
+// ------------------------------------------------
+// x^e por cuadrados sucesivos (e negativo → 1 / x^|e|)
+// ------------------------------------------------
+inline double potenciaEntera(double x, long long e) {
+    bool negativo = e < 0;
+    unsigned long long restante = negativo ? 0ULL - (unsigned long long)e : (unsigned long long)e;
+    double resultado = 1.0;
+    double base = x;
+    while (restante > 0) {
+        if (restante & 1) resultado *= base;
+        base *= base;
+        restante >>= 1;
+    }
+    return negativo ? 1.0 / resultado : resultado;
+}
+
+// ------------------------------------------------
+// Multiplica cada carril de 'potencia' por x^salto (salto >= 0).
+// El salto es el mismo para todos los carriles, así que las decisiones
+// del bucle de bits son escalares y los bucles internos se vectorizan.
+// ------------------------------------------------
+inline void avanzarPotencias(double* potencia, const double* x, unsigned long long salto) {
+    if (salto == 0)
+        return;
+    if (salto == 1) {
+        for (int c = 0; c < CARRILES_EVALUACION; ++c) potencia[c] *= x[c];
+        return;
+    }
+    // Mismo orden de productos que potenciaEntera: x^salto primero, luego
+    // un solo producto con la potencia acumulada (resultados idénticos)
+    double base[CARRILES_EVALUACION], factor[CARRILES_EVALUACION];
+    for (int c = 0; c < CARRILES_EVALUACION; ++c) {
+        base[c] = x[c];
+        factor[c] = 1.0;
+    }
+    while (true) {
+        if (salto & 1)
+            for (int c = 0; c < CARRILES_EVALUACION; ++c) factor[c] *= base[c];
+        salto >>= 1;
+        if (salto == 0) break;
+        for (int c = 0; c < CARRILES_EVALUACION; ++c) base[c] *= base[c];
+    }
+    for (int c = 0; c < CARRILES_EVALUACION; ++c) potencia[c] *= factor[c];
+}
+
 // ===================================================
 // Clase CPolinomio → agrupa varios términos en un solo objeto
+// Las lecturas const no son seguras entre hilos: terminos(),
+// totalTerminos(), aTexto() y las operaciones que los usan fusionan los
+// términos pendientes o arman la vista del modo denso (campos mutable),
+// así que dos hilos que solo leen el mismo polinomio pueden competir.
+// Para compartir un polinomio entre hilos, llamar antes a
+// prepararLectura() y no modificarlo mientras otros lo leen.
 // ===================================================
 class CPolinomio {
 private:
-    vector<CTermino> listaTerminos;  // Contenedor de los términos del polinomio
+    // Términos ya ordenados por exponente creciente, sin ceros ni repetidos
+    mutable vector<CTermino> listaTerminos;
+    // Términos insertados en cualquier orden que aún no se fusionan;
+    // se incorporan en bloque la próxima vez que se lean los términos
+    mutable vector<CTermino> pendientes;
+
+    // Representación densa (cuando esDenso): el coeficiente del exponente
+    // exponenteBase + k está en coefDensos[k], con ceros donde no hay
+    // término; el primer y el último coeficiente nunca son cero.
+    // En este modo listaTerminos es solo una vista que se arma a pedido.
+    bool esDenso = false;
+    vector<double> coefDensos;
+    int exponenteBase = 0;
+    int noNulos = 0;
+    mutable bool vistaValida = false;
+
+    // ------------------------------------------------
+    // Ordena un bloque y suma los términos de igual exponente, en un solo pase
+    // (el orden estable conserva el orden de inserción al sumar)
+    // ------------------------------------------------
+    static void ordenarYCombinar(vector<CTermino>& bloque) {
+        auto porExponente = [](const CTermino& a, const CTermino& b) {
+            return a.leerExp() < b.leerExp();
+        };
+        // Entrada ya ordenada (p. ej. texto de aTexto): basta un pase lineal
+        if (!is_sorted(bloque.begin(), bloque.end(), porExponente))
+            stable_sort(bloque.begin(), bloque.end(), porExponente);
+        size_t destino = 0;
+        for (size_t i = 0; i < bloque.size();) {
+            CTermino acumulado = bloque[i++];
+            while (i < bloque.size() && bloque[i].compararExp(acumulado))
+                acumulado.unir(bloque[i++]);
+            if (acumulado.leerCoef() != 0)
+                bloque[destino++] = acumulado;
+        }
+        bloque.resize(destino);
+    }
+
+    // ------------------------------------------------
+    // Fusiona dos listas ordenadas y combinadas en una sola (O(n + m))
+    // ------------------------------------------------
+    static vector<CTermino> fusionarOrdenadas(const vector<CTermino>& a, const vector<CTermino>& b) {
+        vector<CTermino> resultado;
+        resultado.reserve(a.size() + b.size());
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size()) {
+            if (a[i].leerExp() < b[j].leerExp()) {
+                resultado.push_back(a[i++]);
+            } else if (b[j].leerExp() < a[i].leerExp()) {
+                resultado.push_back(b[j++]);
+            } else {
+                CTermino suma = a[i++];
+                suma.unir(b[j++]);
+                if (suma.leerCoef() != 0)
+                    resultado.push_back(suma);
+            }
+        }
+        resultado.insert(resultado.end(), a.begin() + i, a.end());
+        resultado.insert(resultado.end(), b.begin() + j, b.end());
+        return resultado;
+    }
+
+    // ------------------------------------------------
+    // Incorpora los términos pendientes a la lista ordenada
+    // ------------------------------------------------
+    void fusionarPendientes() const {
+        if (pendientes.empty())
+            return;
+        ordenarYCombinar(pendientes);
+        listaTerminos = fusionarOrdenadas(listaTerminos, pendientes);
+        pendientes.clear();
+    }
+
+    // ------------------------------------------------
+    // Indica si conviene guardar 'terminos' no nulos en 'rango' exponentes
+    // como arreglo denso
+    // ------------------------------------------------
+    static bool convieneDenso(long long terminos, long long rango) {
+        return rango <= LIMITE_TABLA_HASH && terminos >= FRACCION_DENSA * rango;
+    }
+
+    // ------------------------------------------------
+    // Quita los ceros de los extremos del arreglo denso; si no queda
+    // nada, el polinomio vuelve a ser disperso (y nulo)
+    // ------------------------------------------------
+    void recortarDenso() {
+        size_t fin = coefDensos.size();
+        while (fin > 0 && coefDensos[fin - 1] == 0) --fin;
+        size_t inicio = 0;
+        while (inicio < fin && coefDensos[inicio] == 0) ++inicio;
+        if (inicio == fin) {
+            esDenso = false;
+            coefDensos.clear();
+            listaTerminos.clear();
+            noNulos = 0;
+            return;
+        }
+        coefDensos.resize(fin);
+        if (inicio > 0)
+            coefDensos.erase(coefDensos.begin(), coefDensos.begin() + inicio);
+        exponenteBase += (int)inicio;
+    }
+
+    // ------------------------------------------------
+    // Adopta como contenido un arreglo denso (puede traer ceros en
+    // cualquier posición) y elige la representación según la ocupación
+    // ------------------------------------------------
+    void adoptarDenso(vector<double> coeficientes, int base) {
+        pendientes.clear();
+        listaTerminos.clear();
+        coefDensos = move(coeficientes);
+        exponenteBase = base;
+        esDenso = true;
+        vistaValida = false;
+        noNulos = (int)(coefDensos.size() - count(coefDensos.begin(), coefDensos.end(), 0.0));
+        recortarDenso();
+        ajustarRepresentacion();
+    }
+
+    // Menor y mayor exponente (el polinomio no debe ser nulo)
+    int exponenteMenor() const { return esDenso ? exponenteBase : terminos().front().leerExp(); }
+    int exponenteMayor() const {
+        return esDenso ? exponenteBase + (int)coefDensos.size() - 1 : terminos().back().leerExp();
+    }
+
+    // ------------------------------------------------
+    // Suma el polinomio dentro de un arreglo denso cuyo primer elemento
+    // corresponde al exponente 'base'
+    // ------------------------------------------------
+    void acumularEn(double* salida, int base) const {
+        if (esDenso) {
+            double* s = salida + (exponenteBase - base);
+            for (size_t k = 0; k < coefDensos.size(); ++k)
+                s[k] += coefDensos[k];
+        } else {
+            for (const auto& t : terminos())
+                salida[t.leerExp() - base] += t.leerCoef();
+        }
+    }
+
+    // ------------------------------------------------
+    // Coeficientes del exponente 'desde' al 'hasta' en un arreglo denso
+    // ------------------------------------------------
+    vector<double> arregloDenso(int desde, int hasta) const {
+        vector<double> arreglo((size_t)((long long)hasta - desde + 1), 0.0);
+        acumularEn(arreglo.data(), desde);
+        return arreglo;
+    }
+
+    // ------------------------------------------------
+    // Si todos los coeficientes son enteros exactos y ningún exponente es
+    // negativo, los copia (desde el menor exponente) y devuelve true
+    // ------------------------------------------------
+    bool coeficientesEnteros(vector<long long>& coeficientes, int& exponenteMinimo) const {
+        coeficientes.clear();
+        exponenteMinimo = 0;
+        if (totalTerminos() == 0)
+            return true;
+        exponenteMinimo = exponenteMenor();
+        long long rango = (long long)exponenteMayor() - exponenteMinimo + 1;
+        if (exponenteMinimo < 0 || rango > LIMITE_TABLA_HASH)
+            return false;
+        coeficientes.assign((size_t)rango, 0);
+        bool enteros = true;
+        recorrerTerminos([&](const CTermino& t) {
+            double c = t.leerCoef();
+            if (c != floor(c) || fabs(c) >= LIMITE_ENTERO_EXACTO) enteros = false;
+            else coeficientes[t.leerExp() - exponenteMinimo] = (long long)c;
+        });
+        return enteros;
+    }
 
 public:
     // ------------------------------------------------
@@ -101,107 +991,699 @@ public:
     // ------------------------------------------------
     CPolinomio() {}
 
+    // ------------------------------------------------
+    // Constructor en bloque: recibe términos sin ordenar (con exponentes
+    // repetidos o coeficientes nulos) y los combina con un solo
+    // ordenamiento y un solo pase de fusión, O(n log n)
+    // ------------------------------------------------
+    static CPolinomio desdeTerminos(vector<CTermino> terminos) {
+        CPolinomio resultado;
+        ordenarYCombinar(terminos);
+        resultado.listaTerminos = move(terminos);
+        resultado.ajustarRepresentacion();
+        return resultado;
+    }
+
+    // ------------------------------------------------
+    // Agrega muchos términos de una vez (mismo costo que desdeTerminos)
+    // ------------------------------------------------
+    void insertarTerminos(const vector<CTermino>& terminos) {
+        convertirADisperso();
+        pendientes.insert(pendientes.end(), terminos.begin(), terminos.end());
+        fusionarPendientes();
+        ajustarRepresentacion();
+    }
+
     // ------------------------------------------------
     // Devuelve cuántos términos tiene el polinomio actual
     // ------------------------------------------------
     int totalTerminos() const {
+        if (esDenso)
+            return noNulos;
+        fusionarPendientes();
         return listaTerminos.size();
     }
 
+    // ------------------------------------------------
+    // Acceso de solo lectura a los términos, en orden creciente de exponente
+    // (en modo denso arma la lista la primera vez que se pide)
+    // ------------------------------------------------
+    const vector<CTermino>& terminos() const {
+        if (esDenso) {
+            if (!vistaValida) {
+                listaTerminos.clear();
+                listaTerminos.reserve(noNulos);
+                for (size_t k = 0; k < coefDensos.size(); ++k)
+                    if (coefDensos[k] != 0)
+                        listaTerminos.emplace_back(coefDensos[k], exponenteBase + (int)k);
+                vistaValida = true;
+            }
+            return listaTerminos;
+        }
+        fusionarPendientes();
+        return listaTerminos;
+    }
+
+    // ------------------------------------------------
+    // Fusiona los pendientes y, en modo denso, arma la vista de términos.
+    // Hasta la próxima modificación las lecturas const no escriben en el
+    // objeto, y varios hilos pueden leerlo a la vez
+    // ------------------------------------------------
+    void prepararLectura() { terminos(); }
+
+    // ------------------------------------------------
+    // Llama a visitar(termino) por cada término no nulo, en orden
+    // creciente de exponente, sin armar la lista en modo denso
+    // ------------------------------------------------
+    template <typename Visitante>
+    void recorrerTerminos(Visitante visitar) const {
+        if (esDenso) {
+            for (size_t k = 0; k < coefDensos.size(); ++k)
+                if (coefDensos[k] != 0)
+                    visitar(CTermino(coefDensos[k], exponenteBase + (int)k));
+        } else {
+            for (const auto& t : terminos())
+                visitar(t);
+        }
+    }
+
+    // ------------------------------------------------
+    // Representación actual: arreglo denso de coeficientes o lista de
+    // términos. Se elige sola al construir en bloque, al leer y en los
+    // resultados de sumar y multiplicar; insertarTermino no la cambia
+    // salvo que el exponente caiga fuera del arreglo denso.
+    // ------------------------------------------------
+    bool representacionDensa() const { return esDenso; }
+
+    // ------------------------------------------------
+    // Pasa a arreglo denso (si el rango de exponentes lo permite)
+    // ------------------------------------------------
+    void convertirADenso() {
+        if (esDenso)
+            return;
+        fusionarPendientes();
+        if (listaTerminos.empty())
+            return;
+        long long rango = (long long)listaTerminos.back().leerExp() - listaTerminos.front().leerExp() + 1;
+        if (rango > LIMITE_TABLA_HASH)
+            return;
+        exponenteBase = listaTerminos.front().leerExp();
+        coefDensos.assign((size_t)rango, 0.0);
+        for (const auto& t : listaTerminos)
+            coefDensos[t.leerExp() - exponenteBase] = t.leerCoef();
+        noNulos = (int)listaTerminos.size();
+        esDenso = true;
+        vistaValida = true;  // listaTerminos ya coincide con el arreglo
+    }
+
+    // ------------------------------------------------
+    // Pasa a lista de términos
+    // ------------------------------------------------
+    void convertirADisperso() {
+        if (!esDenso)
+            return;
+        terminos();  // arma la lista si hace falta
+        esDenso = false;
+        vector<double>().swap(coefDensos);
+        noNulos = 0;
+    }
+
+    // ------------------------------------------------
+    // Elige la representación según la fracción de exponentes ocupados
+    // ------------------------------------------------
+    void ajustarRepresentacion() {
+        if (esDenso) {
+            if (noNulos < FRACCION_DISPERSA * coefDensos.size())
+                convertirADisperso();
+            return;
+        }
+        fusionarPendientes();
+        if (!listaTerminos.empty() &&
+            convieneDenso((long long)listaTerminos.size(),
+                          (long long)listaTerminos.back().leerExp() - listaTerminos.front().leerExp() + 1))
+            convertirADenso();
+    }
+
     // ------------------------------------------------
     // Inserta un nuevo término, acomodándolo en orden creciente de exponente
     // Si el exponente ya existe, suma sus coeficientes
+    // Costo amortizado O(1) al agregar exponentes crecientes y O(log n)
+    // en orden arbitrario: los términos fuera de orden esperan en
+    // 'pendientes' y se fusionan en bloque cuando ese búfer alcanza el
+    // tamaño de la lista (o cuando se leen los términos)
     // ------------------------------------------------
     void insertarTermino(const CTermino& nuevoTermino) {
         if (nuevoTermino.leerCoef() == 0)
             return;
 
-        bool encontrado = false;
-        for (auto& t : listaTerminos) {
-            if (t.leerExp() == nuevoTermino.leerExp()) {
-                t.unir(nuevoTermino);
-                encontrado = true;
-                break;
+        if (esDenso) {
+            // Dentro del arreglo (o justo después): se suma en su lugar
+            long long k = (long long)nuevoTermino.leerExp() - exponenteBase;
+            if (k >= 0 && k <= (long long)coefDensos.size()) {
+                if (k == (long long)coefDensos.size())
+                    coefDensos.push_back(0.0);
+                double& c = coefDensos[k];
+                bool eraNulo = c == 0;
+                c += nuevoTermino.leerCoef();
+                noNulos += (eraNulo ? 1 : 0) - (c == 0 ? 1 : 0);
+                vistaValida = false;
+                if (c == 0 && (k == 0 || k + 1 == (long long)coefDensos.size()))
+                    recortarDenso();
+                return;
             }
+            convertirADisperso();
         }
 
-        // Si no existía, se agrega
-        if (!encontrado)
-            listaTerminos.push_back(nuevoTermino);
+        if (pendientes.empty()) {
+            // Caso frecuente: el exponente va al final de la lista
+            if (listaTerminos.empty() || listaTerminos.back().leerExp() < nuevoTermino.leerExp()) {
+                listaTerminos.push_back(nuevoTermino);
+                return;
+            }
+            if (listaTerminos.back().compararExp(nuevoTermino)) {
+                listaTerminos.back().unir(nuevoTermino);
+                if (listaTerminos.back().leerCoef() == 0)
+                    listaTerminos.pop_back();
+                return;
+            }
+        }
 
-        organizar();
-        depurarCeros();
+        pendientes.push_back(nuevoTermino);
+        if (pendientes.size() >= max<size_t>(64, listaTerminos.size()))
+            fusionarPendientes();
     }
 
     // ------------------------------------------------
-    // Suma dos polinomios y devuelve el resultado
+    // Suma dos polinomios y devuelve el resultado.
+    // Si alguno es denso y el resultado también lo sería, se suman los
+    // arreglos directamente; si no, se fusionan las listas de términos
     // ------------------------------------------------
     CPolinomio sumar(const CPolinomio& otroPoli) const {
-        CPolinomio resultado = *this;
-        for (const auto& t : otroPoli.listaTerminos)
-            resultado.insertarTermino(t);
+        CPolinomio resultado;
+        if ((esDenso || otroPoli.esDenso) && totalTerminos() > 0 && otroPoli.totalTerminos() > 0) {
+            int base = min(exponenteMenor(), otroPoli.exponenteMenor());
+            long long rango = (long long)max(exponenteMayor(), otroPoli.exponenteMayor()) - base + 1;
+            if (rango <= LIMITE_TABLA_HASH &&
+                totalTerminos() + otroPoli.totalTerminos() >= FRACCION_DISPERSA * rango) {
+                vector<double> suma((size_t)rango, 0.0);
+                acumularEn(suma.data(), base);
+                otroPoli.acumularEn(suma.data(), base);
+                resultado.adoptarDenso(move(suma), base);
+                return resultado;
+            }
+        }
+        resultado.listaTerminos = fusionarOrdenadas(terminos(), otroPoli.terminos());
+        resultado.ajustarRepresentacion();
         return resultado;
     }
 
     // ------------------------------------------------
     // Multiplica dos polinomios y devuelve el resultado
+    // Las filas del núcleo son el operando con menos términos; el
+    // resultado sale ordenado y sin pasar por insertarTermino.
+    // En modo automático, si algún operando es denso y el producto
+    // llena bien su rango, se usa el núcleo denso que corresponde al par
+    // de representaciones; si no, el montículo o el acumulador hash.
     // ------------------------------------------------
-    CPolinomio multiplicar(const CPolinomio& otroPoli) const {
-        CPolinomio resultadoFinal;
-
-        for (const auto& a : listaTerminos) {
-            for (const auto& b : otroPoli.listaTerminos) {
-                CTermino producto = a.producto(b);
-                resultadoFinal.insertarTermino(producto);
+    CPolinomio multiplicar(const CPolinomio& otroPoli,
+                           ModoMultiplicacion modo = ModoMultiplicacion::Automatico) const {
+        if (modo == ModoMultiplicacion::Automatico && (esDenso || otroPoli.esDenso) &&
+            totalTerminos() > 0 && otroPoli.totalTerminos() > 0) {
+            const CPolinomio& f = totalTerminos() <= otroPoli.totalTerminos() ? *this : otroPoli;
+            const CPolinomio& c = totalTerminos() <= otroPoli.totalTerminos() ? otroPoli : *this;
+            int base = f.exponenteMenor() + c.exponenteMenor();
+            long long rango = (long long)f.exponenteMayor() + c.exponenteMayor() - base + 1;
+            long long productos = (long long)f.totalTerminos() * c.totalTerminos();
+            if (rango <= LIMITE_TABLA_HASH && rango <= 2 * productos) {
+                vector<double> producto((size_t)rango, 0.0);
+                if (f.esDenso && c.esDenso)
+                    multiplicarDensos(f.coefDensos.data(), f.coefDensos.size(),
+                                      c.coefDensos.data(), c.coefDensos.size(), producto.data());
+                else if (c.esDenso)
+                    multiplicarDispersoPorDenso(f.terminos(), c.coefDensos.data(), c.coefDensos.size(),
+                                                (long long)c.exponenteBase - base, producto.data());
+                else
+                    multiplicarDensoPorDisperso(f.coefDensos.data(), f.coefDensos.size(), c.terminos(),
+                                                (long long)f.exponenteBase - base, producto.data());
+                CPolinomio resultado;
+                resultado.adoptarDenso(move(producto), base);
+                return resultado;
             }
         }
 
-        resultadoFinal.organizar();
-        resultadoFinal.depurarCeros();
+        const vector<CTermino>& a = terminos();
+        const vector<CTermino>& b = otroPoli.terminos();
+        const vector<CTermino>& filas = a.size() <= b.size() ? a : b;
+        const vector<CTermino>& columnas = a.size() <= b.size() ? b : a;
+
+        CPolinomio resultadoFinal;
+        if (filas.empty())
+            return resultadoFinal;
+        if (modo == ModoMultiplicacion::Automatico)
+            modo = elegirModo(filas, columnas);
+
+        long long desde = (long long)filas.front().leerExp() + columnas.front().leerExp();
+        long long hasta = (long long)filas.back().leerExp() + columnas.back().leerExp() + 1;
+        if (modo == ModoMultiplicacion::Hash)
+            multiplicarConHash(filas, columnas, desde, hasta, resultadoFinal.listaTerminos);
+        else
+            multiplicarConHeap(filas, columnas, desde, hasta, resultadoFinal.listaTerminos);
+        resultadoFinal.ajustarRepresentacion();
         return resultadoFinal;
     }
 
     // ------------------------------------------------
-    // Convierte el polinomio en texto legible
+    // Multiplicación repartida entre hilos (hilos = 0: todos los núcleos)
+    // Cada hilo recorre las filas del operando menor pero solo genera los
+    // productos de su tramo de exponentes del resultado; los tramos se
+    // eligen para que todos tengan casi la misma cantidad de productos.
+    // Cada hilo llena su propia lista (sin bloqueos) y al final se
+    // concatenan en orden. Como cada exponente lo suma un solo hilo en el
+    // mismo orden que multiplicar(), el resultado es idéntico bit a bit.
     // ------------------------------------------------
-    string aTexto() const {
-        if (listaTerminos.empty())
-            return "0";
+    CPolinomio multiplicarParalelo(const CPolinomio& otroPoli, unsigned hilos = 0,
+                                   ModoMultiplicacion modo = ModoMultiplicacion::Automatico) const {
+        const vector<CTermino>& a = terminos();
+        const vector<CTermino>& b = otroPoli.terminos();
+        const vector<CTermino>& filas = a.size() <= b.size() ? a : b;
+        const vector<CTermino>& columnas = a.size() <= b.size() ? b : a;
 
-        stringstream salidaTxt;
-        for (const auto& t : listaTerminos)
-            salidaTxt << t.aTexto();
+        CPolinomio resultadoFinal;
+        if (filas.empty())
+            return resultadoFinal;
+        if (modo == ModoMultiplicacion::Automatico)
+            modo = elegirModo(filas, columnas);
+        if (hilos == 0)
+            hilos = max(1u, thread::hardware_concurrency());
 
-        string texto = salidaTxt.str();
-        if (texto[0] == '+')
-            texto.erase(0, 1); // Elimina el '+' inicial
+        long long desde = (long long)filas.front().leerExp() + columnas.front().leerExp();
+        long long hasta = (long long)filas.back().leerExp() + columnas.back().leerExp() + 1;
+        long long total = (long long)filas.size() * (long long)columnas.size();
 
-        // Reemplaza signos para mejorar la lectura visual
-        string resultado;
-        for (size_t i = 0; i < texto.size(); ++i) {
-            if (texto[i] == '+' || texto[i] == '-')
-                resultado += " " + string(1, texto[i]) + " ";
+        // Cortes del rango de exponentes con igual cantidad de productos
+        vector<long long> cortes = {desde};
+        for (unsigned t = 1; t < hilos; ++t) {
+            long long objetivo = total * t / hilos;
+            long long lo = cortes.back(), hi = hasta;
+            while (lo < hi) {
+                long long medio = lo + (hi - lo) / 2;
+                if (contarProductos(filas, columnas, desde, medio) < objetivo) lo = medio + 1;
+                else hi = medio;
+            }
+            cortes.push_back(lo);
+        }
+        cortes.push_back(hasta);
+
+        vector<vector<CTermino>> parciales(hilos);
+        auto trabajar = [&](unsigned t) {
+            if (modo == ModoMultiplicacion::Hash)
+                multiplicarConHash(filas, columnas, cortes[t], cortes[t + 1], parciales[t]);
+            else
+                multiplicarConHeap(filas, columnas, cortes[t], cortes[t + 1], parciales[t]);
+        };
+        vector<thread> grupo;
+        for (unsigned t = 1; t < hilos; ++t)
+            grupo.emplace_back(trabajar, t);
+        trabajar(0);
+        for (auto& h : grupo)
+            h.join();
+
+        // Los tramos son disjuntos y crecientes: basta concatenarlos
+        size_t totalTerminosResultado = 0;
+        for (const auto& p : parciales) totalTerminosResultado += p.size();
+        resultadoFinal.listaTerminos.reserve(totalTerminosResultado);
+        for (const auto& p : parciales)
+            resultadoFinal.listaTerminos.insert(resultadoFinal.listaTerminos.end(), p.begin(), p.end());
+        resultadoFinal.ajustarRepresentacion();
+        return resultadoFinal;
+    }
+
+    // ------------------------------------------------
+    // División con resto: *this = divisor · cociente + residuo, donde
+    // ningún término del residuo llega al exponente principal del
+    // divisor. Devuelve false si el divisor es nulo.
+    // En modo automático: si el divisor es denso se usa la división
+    // larga sobre arreglos (o la de Newton si cociente y divisor pasan
+    // de UMBRAL_NEWTON coeficientes); si no, la división dispersa.
+    // ------------------------------------------------
+    bool dividir(const CPolinomio& divisor, CPolinomio& cociente, CPolinomio& residuo,
+                 ModoDivision modo = ModoDivision::Automatico) const {
+        if (divisor.totalTerminos() == 0)
+            return false;
+        if (totalTerminos() == 0) {
+            cociente = CPolinomio();
+            residuo = CPolinomio();
+            return true;
+        }
+
+        int base = min(exponenteMenor(), divisor.exponenteMenor());
+        long long rango = (long long)exponenteMayor() - base + 1;
+        long long largoCociente = (long long)exponenteMayor() - divisor.exponenteMayor() + 1;
+        long long largoDivisor = (long long)divisor.exponenteMayor() - divisor.exponenteMenor() + 1;
+        if (modo == ModoDivision::Automatico) {
+            if (!divisor.esDenso)
+                modo = ModoDivision::Dispersa;
+            else if (esDenso && largoCociente >= (long long)UMBRAL_NEWTON &&
+                     largoDivisor >= (long long)UMBRAL_NEWTON)
+                modo = ModoDivision::Newton;
             else
-                resultado += texto[i];
+                modo = ModoDivision::Densa;
+        }
+        if (modo != ModoDivision::Dispersa && (rango > LIMITE_TABLA_HASH || largoDivisor > LIMITE_TABLA_HASH))
+            modo = ModoDivision::Dispersa;
+
+        if (modo == ModoDivision::Dispersa) {
+            vector<CTermino> q, r;
+            dividirConHeap(terminos(), divisor.terminos(), q, r);
+            cociente = desdeTerminos(move(q));
+            residuo = desdeTerminos(move(r));
+            return true;
+        }
+
+        vector<double> resto = arregloDenso(base, exponenteMayor());
+        vector<double> g = divisor.arregloDenso(divisor.exponenteMenor(), divisor.exponenteMayor());
+        vector<double> q;
+        if (modo == ModoDivision::Newton)
+            dividirNewton(resto, base, g.data(), g.size(), divisor.exponenteMenor(), q);
+        else
+            dividirDenso(resto, base, g.data(), g.size(), divisor.exponenteMenor(), q);
+        CPolinomio nuevoCociente, nuevoResiduo;
+        nuevoCociente.adoptarDenso(move(q), 0);
+        nuevoResiduo.adoptarDenso(move(resto), base);
+        cociente = move(nuevoCociente);
+        residuo = move(nuevoResiduo);
+        return true;
+    }
+
+    // ------------------------------------------------
+    // MCD exacto cuando todos los coeficientes son enteros (|c| < 2^53)
+    // y los exponentes no son negativos. Se calcula el MCD módulo varios
+    // primos (algoritmo modular de Brown) y se reconstruye el resultado
+    // con el teorema chino del resto sobre todas las imágenes del menor
+    // grado visto (hasta MAX_PRIMOS_CRT); el candidato se acepta solo si
+    // divide exactamente a ambas partes primitivas sobre los enteros. El
+    // resultado tiene coeficientes enteros: el MCD de los contenidos por
+    // la parte primitiva, con coeficiente principal positivo.
+    // Devuelve false si no se cumplen las condiciones o si el resultado
+    // no cabe en un double sin redondeo.
+    // ------------------------------------------------
+    bool mcdModular(const CPolinomio& otro, CPolinomio& resultado) const {
+#if !defined(MCD_MODULAR_DISPONIBLE)
+        (void)otro;
+        (void)resultado;
+        return false;
+#else
+        vector<long long> a, b;
+        int minimoA, minimoB;
+        if (!coeficientesEnteros(a, minimoA) || !otro.coeficientesEnteros(b, minimoB))
+            return false;
+        if (a.empty() || b.empty()) {
+            // mcd(0, b) = b normalizado
+            const vector<long long>& unico = a.empty() ? b : a;
+            int minimo = a.empty() ? minimoB : minimoA;
+            if (unico.empty()) {
+                resultado = CPolinomio();
+                return true;
+            }
+            vector<CTermino> t;
+            long long signo = unico.back() < 0 ? -1 : 1;
+            for (size_t k = 0; k < unico.size(); ++k)
+                if (unico[k] != 0) t.emplace_back((double)(signo * unico[k]), minimo + (int)k);
+            resultado = desdeTerminos(move(t));
+            return true;
+        }
+
+        // Contenidos (MCD de los coeficientes) y partes primitivas
+        auto contenido = [](const vector<long long>& v) {
+            long long c = 0;
+            for (long long x : v) c = gcd(c, x);
+            return c;
+        };
+        long long contenidoA = contenido(a), contenidoB = contenido(b);
+        for (auto& x : a) x /= contenidoA;
+        for (auto& x : b) x /= contenidoB;
+        long long contenidoMCD = gcd(contenidoA, contenidoB);
+        long long gamma = gcd(a.back(), b.back());
+
+        auto reducir = [](const vector<long long>& v, uint32_t p) {
+            vector<uint32_t> r(v.size());
+            for (size_t k = 0; k < v.size(); ++k) r[k] = reducirModulo(v[k], p);
+            while (!r.empty() && r.back() == 0) r.pop_back();
+            return r;
+        };
+
+        // Reconstrucción acumulada: 'residuos' son los coeficientes de
+        // gamma · MCD / principal módulo 'modulo' (producto de los primos usados)
+        size_t mejorGrado = min(a.size(), b.size());  // Cota: grado + 1
+        vector<NaturalAmplio> residuos;
+        NaturalAmplio modulo = 1;
+        size_t primosUsados = 0;
+        vector<long long> candidato;
+        bool encontrado = false;
+        for (uint32_t p : PRIMOS_MCD) {
+            if (reducirModulo(a.back(), p) == 0 || reducirModulo(b.back(), p) == 0)
+                continue;  // El primo reduce el grado: no sirve
+            vector<uint32_t> imagen = mcdModulo(reducir(a, p), reducir(b, p), p);
+            if (imagen.size() > mejorGrado)
+                continue;  // Primo desafortunado
+            if (imagen.size() < mejorGrado || primosUsados == 0) {
+                // Grado menor: las imágenes anteriores eran de primos desafortunados
+                mejorGrado = imagen.size();
+                residuos.assign(mejorGrado, 0);
+                modulo = 1;
+                primosUsados = 0;
+            } else if (primosUsados == MAX_PRIMOS_CRT) {
+                break;  // El módulo no puede crecer más: el MCD no cabe
+            }
+            uint32_t escala = reducirModulo(gamma, p);
+            uint32_t inversoModuloP = inversoModulo((uint32_t)(modulo % p), p);
+            for (size_t k = 0; k < mejorGrado; ++k) {
+                // Garner: x + modulo · ((r − x) / modulo mod p)
+                uint32_t r = multiplicarModulo(imagen[k], escala, p);
+                uint32_t x = (uint32_t)(residuos[k] % p);
+                uint32_t t = multiplicarModulo((uint32_t)((r + (uint64_t)p - x) % p), inversoModuloP, p);
+                residuos[k] += modulo * t;
+            }
+            modulo *= p;
+            primosUsados++;
+
+            // Candidato: representantes simétricos y parte primitiva
+            vector<NaturalAmplio> magnitud(mejorGrado);
+            vector<bool> negativo(mejorGrado);
+            NaturalAmplio c = 0;
+            for (size_t k = 0; k < mejorGrado; ++k) {
+                negativo[k] = residuos[k] > modulo / 2;
+                magnitud[k] = negativo[k] ? modulo - residuos[k] : residuos[k];
+                c = mcdAmplio(c, magnitud[k]);
+            }
+            if (c == 0)
+                continue;
+            bool cabe = true;
+            candidato.assign(mejorGrado, 0);
+            for (size_t k = 0; k < mejorGrado && cabe; ++k) {
+                NaturalAmplio m = magnitud[k] / c;
+                cabe = m < ((NaturalAmplio)1 << 53);
+                candidato[k] = negativo[k] ? -(long long)m : (long long)m;
+            }
+            if (!cabe)
+                continue;  // Hace falta otro primo
+            if (candidato.back() < 0)
+                for (auto& x : candidato) x = -x;
+
+            // Comprobación exacta: el candidato divide a ambas partes primitivas
+            if (divideExactamente(a, candidato) && divideExactamente(b, candidato)) {
+                encontrado = true;
+                break;
+            }
+        }
+        if (!encontrado)
+            return false;
+
+        int minimo = min(minimoA, minimoB);
+        vector<CTermino> t;
+        for (size_t k = 0; k < candidato.size(); ++k) {
+            double coef = (double)candidato[k] * (double)contenidoMCD;
+            if (fabs(coef) >= LIMITE_ENTERO_EXACTO)
+                return false;
+            if (coef != 0) t.emplace_back(coef, minimo + (int)k);
+        }
+        resultado = desdeTerminos(move(t));
+        return true;
+#endif
+    }
+
+    // ------------------------------------------------
+    // Máximo común divisor. Con coeficientes enteros usa mcdModular
+    // (exacto); si no, Euclides en punto flotante descartando en cada
+    // resto los coeficientes menores que 'tolerancia' veces el mayor, y
+    // el resultado se devuelve mónico.
+    // ------------------------------------------------
+    CPolinomio mcd(const CPolinomio& otro, double tolerancia = 1e-9) const {
+        CPolinomio resultado;
+        if (mcdModular(otro, resultado))
+            return resultado;
+
+        CPolinomio a = *this, b = otro;
+        while (b.totalTerminos() > 0) {
+            CPolinomio q, r;
+            a.dividir(b, q, r);
+            double mayor = 0;
+            b.recorrerTerminos([&](const CTermino& t) { mayor = max(mayor, fabs(t.leerCoef())); });
+            vector<CTermino> limpio;
+            r.recorrerTerminos([&](const CTermino& t) {
+                if (fabs(t.leerCoef()) > tolerancia * mayor) limpio.push_back(t);
+            });
+            a = move(b);
+            b = desdeTerminos(move(limpio));
+        }
+        if (a.totalTerminos() == 0)
+            return a;
+        double lider = a.terminos().back().leerCoef();
+        vector<CTermino> monico;
+        a.recorrerTerminos([&](const CTermino& t) {
+            monico.emplace_back(t.leerCoef() / lider, t.leerExp());
+        });
+        return desdeTerminos(move(monico));
+    }
+
+    // ------------------------------------------------
+    // Evalúa el polinomio en x. Los exponentes se recorren en orden
+    // creciente y la potencia avanza por cuadrados sucesivos en cada salto
+    // ------------------------------------------------
+    double evaluar(double x) const {
+        double potencia = 1, total = 0;
+        bool primero = true;
+        long long anterior = 0;
+        recorrerTerminos([&](const CTermino& t) {
+            if (primero) {
+                potencia = potenciaEntera(x, t.leerExp());
+                total = t.leerCoef() * potencia;
+                primero = false;
+            } else {
+                long long salto = (long long)t.leerExp() - anterior;
+                potencia *= salto == 1 ? x : potenciaEntera(x, salto);
+                total += t.leerCoef() * potencia;
+            }
+            anterior = t.leerExp();
+        });
+        return total;
+    }
+
+    // ------------------------------------------------
+    // Evalúa el polinomio en n puntos. Los puntos se procesan en grupos
+    // de CARRILES_EVALUACION: cada término se aplica a todo el grupo con
+    // bucles que el compilador vectoriza. Da los mismos valores que
+    // evaluar() punto por punto.
+    // ------------------------------------------------
+    void evaluarLote(const double* puntos, double* salida, size_t n) const {
+        const vector<CTermino>& lista = terminos();
+        if (lista.empty()) {
+            fill(salida, salida + n, 0.0);
+            return;
+        }
+        const int C = CARRILES_EVALUACION;
+        size_t i = 0;
+        for (; i + C <= n; i += C) {
+            const double* x = puntos + i;
+            double potencia[C], total[C];
+            for (int c = 0; c < C; ++c) potencia[c] = potenciaEntera(x[c], lista[0].leerExp());
+            double coef = lista[0].leerCoef();
+            for (int c = 0; c < C; ++c) total[c] = coef * potencia[c];
+            for (size_t k = 1; k < lista.size(); ++k) {
+                avanzarPotencias(potencia, x,
+                                 (unsigned long long)((long long)lista[k].leerExp() - lista[k - 1].leerExp()));
+                coef = lista[k].leerCoef();
+                for (int c = 0; c < C; ++c) total[c] += coef * potencia[c];
+            }
+            for (int c = 0; c < C; ++c) salida[i + c] = total[c];
+        }
+        for (; i < n; ++i)
+            salida[i] = evaluar(puntos[i]);
+    }
+
+    // Versión con vectores (la salida toma el tamaño de la entrada)
+    vector<double> evaluarLote(const vector<double>& puntos) const {
+        vector<double> salida(puntos.size());
+        evaluarLote(puntos.data(), salida.data(), puntos.size());
+        return salida;
+    }
+
+    // ------------------------------------------------
+    // Escribe el texto del polinomio, por trozos, a través de 'enviar'
+    // (cualquier función que reciba (const char*, size_t)).
+    // Un solo búfer fijo; los signos se separan con espacios al vuelo:
+    // se quita el '+' inicial y cada '+' o '-' se escribe como " + " o " - "
+    // ------------------------------------------------
+    template <typename Destino>
+    void serializar(Destino enviar, size_t tamBufer = 1 << 16) const {
+        if (totalTerminos() == 0) {
+            enviar("0", 1);
+            return;
         }
 
+        // Cada carácter del término puede convertirse en hasta 3
+        const size_t MAX_POR_TERMINO = 3 * CTermino::MAX_TEXTO;
+        vector<char> bufer(max(tamBufer, 2 * MAX_POR_TERMINO));
+        char* inicio = bufer.data();
+        char* p = inicio;
+        char* limite = inicio + bufer.size() - MAX_POR_TERMINO;
+        bool primero = true;
+
+        char termino[CTermino::MAX_TEXTO];
+        recorrerTerminos([&](const CTermino& t) {
+            p = copiarConSignosEspaciados(termino, t.escribirTexto(termino), p, primero);
+            if (p >= limite) {
+                enviar(inicio, p - inicio);
+                p = inicio;
+            }
+        });
+        if (p > inicio)
+            enviar(inicio, p - inicio);
+    }
+
+    // ------------------------------------------------
+    // Convierte el polinomio en texto legible
+    // ------------------------------------------------
+    string aTexto() const {
+        string resultado;
+        resultado.reserve(12 * totalTerminos() + 1);
+        serializar([&resultado](const char* datos, size_t n) { resultado.append(datos, n); });
         return resultado;
     }
 
+    // ------------------------------------------------
+    // Escribe el texto directamente en un descriptor de archivo
+    // (1 = salida estándar, o uno obtenido con open()).
+    // Devuelve false si alguna escritura falla.
+    // ------------------------------------------------
+    bool escribirEnDescriptor(int descriptor) const {
+        bool correcto = true;
+        serializar([&](const char* datos, size_t n) {
+            while (correcto && n > 0) {
+                auto escritos = escribirBytes(descriptor, datos, (unsigned)n);
+                if (escritos <= 0) { correcto = false; break; }
+                datos += escritos;
+                n -= (size_t)escritos;
+            }
+        });
+        return correcto;
+    }
+
     // ------------------------------------------------
     // Ordena los términos del polinomio de menor a mayor exponente
     // ------------------------------------------------
     void organizar() {
-        sort(listaTerminos.begin(), listaTerminos.end(),
-             [](const CTermino& a, const CTermino& b) {
-                 return a.leerExp() < b.leerExp();
-             });
+        fusionarPendientes();
+        ajustarRepresentacion();
     }
 
     // ------------------------------------------------
     // Borra los términos cuyo coeficiente sea cero
     // ------------------------------------------------
     void depurarCeros() {
+        if (esDenso)
+            return;  // El arreglo denso no cuenta los ceros como términos
+        fusionarPendientes();
         listaTerminos.erase(
             remove_if(listaTerminos.begin(), listaTerminos.end(),
                       [](const CTermino& t) { return t.leerCoef() == 0; }),
@@ -209,10 +1691,1323 @@ public:
     }
 };
 
+// ===================================================
+// Lectura de polinomios en el formato de aTexto()
+// Ejemplos válidos: "7 - 2x + 3x^2 + 4x^3", " - 1 + x", "0",
+// "1e - 07x^4" (aTexto separa también el signo del exponente decimal).
+// Se recorre el texto sin copiarlo, los números se leen con from_chars y
+// los términos se entregan juntos a CPolinomio::desdeTerminos.
+// ===================================================
+struct ErrorLectura {
+    size_t posicion = 0;  // Byte (desde 0) donde se detectó el error
+    string mensaje;       // Descripción del problema
+};
+
+// ------------------------------------------------
+// Lee el coeficiente que empieza en 'p'. Si el exponente decimal viene
+// separado ("1e - 07"), se compacta en un búfer local antes de convertir.
+// Devuelve el puntero siguiente al número, o nullptr si no hay número.
+// ------------------------------------------------
+const char* leerCoeficiente(const char* p, const char* fin, double& valor) {
+    const char* q = p;
+    while (q < fin && ((*q >= '0' && *q <= '9') || *q == '.')) ++q;
+    if (q == p) {
+        auto r = from_chars(p, fin, valor);  // inf / nan
+        return r.ec == errc() ? r.ptr : nullptr;
+    }
+    if (q == fin || (*q != 'e' && *q != 'E')) {
+        auto r = from_chars(p, q, valor);
+        return r.ec == errc() && r.ptr == q ? q : nullptr;
+    }
+
+    // Mantisa + exponente con posibles espacios alrededor del signo
+    char compacto[64];
+    size_t largo = q - p;
+    if (largo + 8 > sizeof(compacto))
+        return nullptr;
+    memcpy(compacto, p, largo);
+    compacto[largo++] = 'e';
+    ++q;
+    while (q < fin && *q == ' ') ++q;
+    if (q < fin && (*q == '+' || *q == '-')) compacto[largo++] = *q++;
+    while (q < fin && *q == ' ') ++q;
+    const char* digitos = q;
+    while (q < fin && *q >= '0' && *q <= '9' && largo < sizeof(compacto)) compacto[largo++] = *q++;
+    if (q == digitos)
+        return nullptr;
+    auto r = from_chars(compacto, compacto + largo, valor);
+    return r.ec == errc() && r.ptr == compacto + largo ? q : nullptr;
+}
+
+// ------------------------------------------------
+// Convierte el texto en la lista de términos (sin ordenar)
+// ------------------------------------------------
+bool leerTerminos(string_view texto, vector<CTermino>& terminos, ErrorLectura* error = nullptr) {
+    const char* inicio = texto.data();
+    const char* p = inicio;
+    const char* fin = inicio + texto.size();
+    auto fallar = [&](const char* donde, const char* mensaje) {
+        if (error) {
+            error->posicion = donde - inicio;
+            error->mensaje = mensaje;
+        }
+        return false;
+    };
+    auto saltarEspacios = [&] {
+        while (p < fin && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+    };
+
+    terminos.reserve(terminos.size() + texto.size() / 8);
+    saltarEspacios();
+    if (p == fin)
+        return fallar(p, "texto vacío");
+
+    bool primero = true;
+    while (p < fin) {
+        // Signo: opcional en el primer término, obligatorio en los demás
+        double signo = 1;
+        if (*p == '+' || *p == '-') {
+            signo = *p == '-' ? -1 : 1;
+            ++p;
+            saltarEspacios();
+        } else if (!primero) {
+            return fallar(p, "se esperaba '+' o '-'");
+        }
+        primero = false;
+
+        // Coeficiente (opcional si hay 'x')
+        const char* inicioTermino = p;
+        double coeficiente = 1;
+        bool hayCoeficiente = false;
+        if (p < fin && *p != 'x') {
+            const char* siguiente = leerCoeficiente(p, fin, coeficiente);
+            if (!siguiente)
+                return fallar(p, "se esperaba un número o 'x'");
+            p = siguiente;
+            hayCoeficiente = true;
+        }
+
+        // Parte literal x o x^n
+        int exponente = 0;
+        if (p < fin && *p == 'x') {
+            ++p;
+            exponente = 1;
+            if (p < fin && *p == '^') {
+                ++p;
+                auto r = from_chars(p, fin, exponente);
+                if (r.ec != errc())
+                    return fallar(p, "exponente inválido");
+                p = r.ptr;
+            }
+        } else if (!hayCoeficiente) {
+            return fallar(inicioTermino, "término vacío");
+        }
+
+        terminos.emplace_back(signo * coeficiente, exponente);
+        saltarEspacios();
+    }
+    return true;
+}
+
+// ------------------------------------------------
+// Lee un polinomio desde texto. Si falla, 'destino' no cambia.
+// ------------------------------------------------
+bool leerPolinomio(string_view texto, CPolinomio& destino, ErrorLectura* error = nullptr) {
+    vector<CTermino> terminos;
+    if (!leerTerminos(texto, terminos, error))
+        return false;
+    destino = CPolinomio::desdeTerminos(move(terminos));
+    return true;
+}
+
+// ===================================================
+// Archivo de solo lectura mapeado en memoria (en Windows se lee completo)
+// ===================================================
+class ArchivoMapeado {
+private:
+    const char* datos = nullptr;
+    size_t tamano = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    string contenido;
+#endif
+
+public:
+    // Constructor: abre y mapea el archivo; valido() indica si se pudo
+    explicit ArchivoMapeado(const string& ruta) {
+#if defined(_WIN32) || defined(_WIN64)
+        ifstream archivo(ruta, ios::binary);
+        if (!archivo) return;
+        contenido.assign(istreambuf_iterator<char>(archivo), istreambuf_iterator<char>());
+        datos = contenido.data();
+        tamano = contenido.size();
+#else
+        int descriptor = open(ruta.c_str(), O_RDONLY);
+        if (descriptor < 0) return;
+        struct stat info;
+        if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+            void* mapa = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapa != MAP_FAILED) {
+                madvise(mapa, (size_t)info.st_size, MADV_SEQUENTIAL);
+                datos = (const char*)mapa;
+                tamano = (size_t)info.st_size;
+            }
+        } else if (fstat(descriptor, &info) == 0) {
+            datos = "";  // Archivo vacío: válido pero sin contenido
+        }
+        close(descriptor);
+#endif
+    }
+
+    // Destructor: libera el mapeo
+    ~ArchivoMapeado() {
+#if !defined(_WIN32) && !defined(_WIN64)
+        if (datos && tamano > 0) munmap((void*)datos, tamano);
+#endif
+    }
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    bool valido() const { return datos != nullptr; }
+    string_view texto() const { return string_view(datos ? datos : "", tamano); }
+};
+
+// ------------------------------------------------
+// Lee un polinomio desde un archivo de texto
+// ------------------------------------------------
+bool leerPolinomioDeArchivo(const string& ruta, CPolinomio& destino, ErrorLectura* error = nullptr) {
+    ArchivoMapeado archivo(ruta);
+    if (!archivo.valido()) {
+        if (error) {
+            error->posicion = 0;
+            error->mensaje = "no se pudo abrir " + ruta;
+        }
+        return false;
+    }
+    return leerPolinomio(archivo.texto(), destino, error);
+}
+
+// ===================================================
+// Polinomios dispersos en varias variables (hasta 8)
+// Los exponentes de cada monomio van empaquetados en un entero de 64
+// bits: 8 bits por variable (la primera en el byte más alto), 7 para el
+// exponente (0 a 127) y el bit alto libre para detectar desbordes.
+// Comparar monomios es comparar enteros (orden lexicográfico) y
+// multiplicarlos es sumarlos: dos exponentes válidos suman a lo sumo 254,
+// que cabe en el campo sin acarrear al vecino, y si la suma pasa de 127
+// se enciende el bit alto del campo (BITS_GUARDA).
+// ===================================================
+const int MAX_VARIABLES = 8;
+const int MAX_EXPONENTE_MULTI = 127;
+const uint64_t BITS_GUARDA = 0x8080808080808080ULL;
+const char LETRAS_VARIABLES[MAX_VARIABLES + 1] = "xyzuvwst";
+
+// Desplazamiento del campo de la variable v dentro del monomio
+inline int desplazamientoVariable(int v) { return 8 * (MAX_VARIABLES - 1 - v); }
+
+// Exponente de la variable v en un monomio empaquetado
+inline int exponenteEn(uint64_t monomio, int v) {
+    return (int)((monomio >> desplazamientoVariable(v)) & 0x7F);
+}
+
+// Indica si los exponentes se pueden empaquetar en un polinomio de
+// 'variables' variables: cada uno entre 0 y 127 y ninguno distinto de
+// cero más allá de la última variable
+inline bool exponentesValidos(const vector<int>& exponentes, int variables = MAX_VARIABLES) {
+    for (size_t v = 0; v < exponentes.size(); ++v) {
+        if (exponentes[v] < 0 || exponentes[v] > MAX_EXPONENTE_MULTI) return false;
+        if (exponentes[v] != 0 && (int)v >= variables) return false;
+    }
+    return true;
+}
+
+// Empaqueta un arreglo de exponentes (comprobados con exponentesValidos)
+inline uint64_t empaquetarMonomio(const vector<int>& exponentes) {
+    uint64_t monomio = 0;
+    for (size_t v = 0; v < exponentes.size() && v < (size_t)MAX_VARIABLES; ++v)
+        monomio |= (uint64_t)(exponentes[v] & 0x7F) << desplazamientoVariable((int)v);
+    return monomio;
+}
+
+// Término de un polinomio en varias variables
+struct TerminoMulti {
+    double coef;        // Coeficiente
+    uint64_t monomio;   // Exponentes empaquetados
+
+    // Texto con el mismo estilo que CTermino: +3x^2yz^4
+    size_t escribirTexto(char* destino, int numVariables) const {
+        if (coef == 0)
+            return 0;
+        char* p = destino;
+        char* fin = destino + 64 + 5 * MAX_VARIABLES;
+        *p++ = coef > 0 ? '+' : '-';
+        double valorAbs = fabs(coef);
+        if (valorAbs != 1 || monomio == 0)
+            p = to_chars(p, fin, valorAbs, chars_format::general, 6).ptr;
+        for (int v = 0; v < numVariables; ++v) {
+            int e = exponenteEn(monomio, v);
+            if (e == 0) continue;
+            *p++ = LETRAS_VARIABLES[v];
+            if (e > 1) {
+                *p++ = '^';
+                p = to_chars(p, fin, e).ptr;
+            }
+        }
+        return p - destino;
+    }
+};
+
+// ===================================================
+// Clase CPolinomioMulti → polinomio disperso en 1 a 8 variables
+// (x, y, z, u, v, w, s, t), con términos ordenados por monomio
+// ===================================================
+class CPolinomioMulti {
+private:
+    int numVariables;                    // Cantidad de variables (1-8)
+    vector<TerminoMulti> listaTerminos;  // Orden creciente de monomio, sin ceros ni repetidos
+
+    // ------------------------------------------------
+    // Ordena y suma los términos de igual monomio en un solo pase
+    // ------------------------------------------------
+    static void ordenarYCombinar(vector<TerminoMulti>& bloque) {
+        auto porMonomio = [](const TerminoMulti& a, const TerminoMulti& b) {
+            return a.monomio < b.monomio;
+        };
+        if (!is_sorted(bloque.begin(), bloque.end(), porMonomio))
+            stable_sort(bloque.begin(), bloque.end(), porMonomio);
+        size_t destino = 0;
+        for (size_t i = 0; i < bloque.size();) {
+            TerminoMulti acumulado = bloque[i++];
+            while (i < bloque.size() && bloque[i].monomio == acumulado.monomio)
+                acumulado.coef += bloque[i++].coef;
+            if (acumulado.coef != 0)
+                bloque[destino++] = acumulado;
+        }
+        bloque.resize(destino);
+    }
+
+public:
+    // ------------------------------------------------
+    // Constructor: polinomio nulo en la cantidad de variables indicada
+    // ------------------------------------------------
+    explicit CPolinomioMulti(int variables = 3)
+        : numVariables(max(1, min(variables, MAX_VARIABLES))) {}
+
+    // ------------------------------------------------
+    // Constructor en bloque a partir de términos sin ordenar
+    // ------------------------------------------------
+    static CPolinomioMulti desdeTerminos(int variables, vector<TerminoMulti> terminos) {
+        CPolinomioMulti resultado(variables);
+        ordenarYCombinar(terminos);
+        resultado.listaTerminos = move(terminos);
+        return resultado;
+    }
+
+    // ------------------------------------------------
+    // Inserta coef · x^e0 · y^e1 ... Devuelve false (sin cambiar nada) si
+    // algún exponente no está entre 0 y 127 o usa una variable de más.
+    // ------------------------------------------------
+    bool insertarTermino(double coef, const vector<int>& exponentes) {
+        if (!exponentesValidos(exponentes, numVariables))
+            return false;
+        if (coef == 0)
+            return true;
+        TerminoMulti nuevo{coef, empaquetarMonomio(exponentes)};
+        auto pos = lower_bound(listaTerminos.begin(), listaTerminos.end(), nuevo,
+                               [](const TerminoMulti& a, const TerminoMulti& b) {
+                                   return a.monomio < b.monomio;
+                               });
+        if (pos != listaTerminos.end() && pos->monomio == nuevo.monomio) {
+            pos->coef += coef;
+            if (pos->coef == 0)
+                listaTerminos.erase(pos);
+        } else {
+            listaTerminos.insert(pos, nuevo);
+        }
+        return true;
+    }
+
+    int obtenerVariables() const { return numVariables; }
+    int totalTerminos() const { return (int)listaTerminos.size(); }
+    const vector<TerminoMulti>& terminos() const { return listaTerminos; }
+
+    // ------------------------------------------------
+    // Suma por fusión de las dos listas ordenadas
+    // ------------------------------------------------
+    CPolinomioMulti sumar(const CPolinomioMulti& otro) const {
+        CPolinomioMulti resultado(max(numVariables, otro.numVariables));
+        const vector<TerminoMulti>& a = listaTerminos;
+        const vector<TerminoMulti>& b = otro.listaTerminos;
+        resultado.listaTerminos.reserve(a.size() + b.size());
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size()) {
+            if (a[i].monomio < b[j].monomio) {
+                resultado.listaTerminos.push_back(a[i++]);
+            } else if (b[j].monomio < a[i].monomio) {
+                resultado.listaTerminos.push_back(b[j++]);
+            } else {
+                double suma = a[i].coef + b[j].coef;
+                if (suma != 0)
+                    resultado.listaTerminos.push_back({suma, a[i].monomio});
+                ++i;
+                ++j;
+            }
+        }
+        resultado.listaTerminos.insert(resultado.listaTerminos.end(), a.begin() + i, a.end());
+        resultado.listaTerminos.insert(resultado.listaTerminos.end(), b.begin() + j, b.end());
+        return resultado;
+    }
+
+    // ------------------------------------------------
+    // Indica si el producto cabe en 7 bits por variable
+    // ------------------------------------------------
+    bool puedeMultiplicar(const CPolinomioMulti& otro) const {
+        for (int v = 0; v < MAX_VARIABLES; ++v) {
+            int maxA = 0, maxB = 0;
+            for (const auto& t : listaTerminos) maxA = max(maxA, exponenteEn(t.monomio, v));
+            for (const auto& t : otro.listaTerminos) maxB = max(maxB, exponenteEn(t.monomio, v));
+            if (maxA + maxB > MAX_EXPONENTE_MULTI)
+                return false;
+        }
+        return true;
+    }
+
+    // ------------------------------------------------
+    // Producto por fusión con montículo (mismo esquema que CPolinomio):
+    // un cursor por término del operando menor; sumar un monomio fijo
+    // conserva el orden, así cada fila ya sale ordenada.
+    // Devuelve false si algún exponente del producto pasaría de 127 (lo
+    // detectan los bits de guarda); en ese caso 'resultado' queda nulo.
+    // ------------------------------------------------
+    bool multiplicar(const CPolinomioMulti& otro, CPolinomioMulti& resultado) const {
+        resultado = CPolinomioMulti(max(numVariables, otro.numVariables));
+        const vector<TerminoMulti>& filas =
+            listaTerminos.size() <= otro.listaTerminos.size() ? listaTerminos : otro.listaTerminos;
+        const vector<TerminoMulti>& columnas =
+            listaTerminos.size() <= otro.listaTerminos.size() ? otro.listaTerminos : listaTerminos;
+        if (filas.empty())
+            return true;
+
+        struct Cursor {
+            uint64_t monomio;
+            unsigned fila, columna;
+        };
+        auto menor = [](const Cursor& x, const Cursor& y) {
+            return x.monomio != y.monomio ? x.monomio < y.monomio : x.fila < y.fila;
+        };
+        vector<Cursor> monticulo;
+        monticulo.reserve(filas.size());
+        for (size_t i = 0; i < filas.size(); ++i)
+            monticulo.push_back({filas[i].monomio + columnas[0].monomio, (unsigned)i, 0});
+        // Las filas empiezan en orden creciente: ya es un montículo válido
+        auto hundir = [&](size_t k) {
+            Cursor c = monticulo[k];
+            size_t n = monticulo.size();
+            while (true) {
+                size_t hijo = 2 * k + 1;
+                if (hijo >= n) break;
+                if (hijo + 1 < n && menor(monticulo[hijo + 1], monticulo[hijo])) ++hijo;
+                if (!menor(monticulo[hijo], c)) break;
+                monticulo[k] = monticulo[hijo];
+                k = hijo;
+            }
+            monticulo[k] = c;
+        };
+
+        vector<TerminoMulti>& salida = resultado.listaTerminos;
+        while (!monticulo.empty()) {
+            uint64_t monomio = monticulo[0].monomio;
+            if (monomio & BITS_GUARDA) {
+                salida.clear();
+                return false;
+            }
+            double coeficiente = 0;
+            while (!monticulo.empty() && monticulo[0].monomio == monomio) {
+                Cursor& c = monticulo[0];
+                coeficiente += filas[c.fila].coef * columnas[c.columna].coef;
+                if (++c.columna < columnas.size()) {
+                    c.monomio = filas[c.fila].monomio + columnas[c.columna].monomio;
+                    hundir(0);
+                } else {
+                    monticulo[0] = monticulo.back();
+                    monticulo.pop_back();
+                    if (!monticulo.empty()) hundir(0);
+                }
+            }
+            if (coeficiente != 0)
+                salida.push_back({coeficiente, monomio});
+        }
+        return true;
+    }
+
+    // ------------------------------------------------
+    // Evalúa en un punto (un valor por variable). Las potencias de cada
+    // variable se calculan una sola vez hasta el mayor exponente usado.
+    // ------------------------------------------------
+    double evaluar(const vector<double>& valores) const {
+        vector<double> potencias[MAX_VARIABLES];
+        for (int v = 0; v < numVariables; ++v) {
+            int maximo = 0;
+            for (const auto& t : listaTerminos) maximo = max(maximo, exponenteEn(t.monomio, v));
+            double x = v < (int)valores.size() ? valores[v] : 0.0;
+            potencias[v].assign(maximo + 1, 1.0);
+            for (int e = 1; e <= maximo; ++e)
+                potencias[v][e] = potencias[v][e - 1] * x;
+        }
+        double total = 0;
+        for (const auto& t : listaTerminos) {
+            double valor = t.coef;
+            for (int v = 0; v < numVariables; ++v)
+                valor *= potencias[v][exponenteEn(t.monomio, v)];
+            total += valor;
+        }
+        return total;
+    }
+
+    // ------------------------------------------------
+    // Texto con el mismo formato que CPolinomio::aTexto
+    // ------------------------------------------------
+    string aTexto() const {
+        if (listaTerminos.empty())
+            return "0";
+        string resultado;
+        resultado.reserve(16 * listaTerminos.size());
+        char termino[64 + 5 * MAX_VARIABLES];
+        char expandido[3 * sizeof(termino)];
+        bool primero = true;
+        for (const auto& t : listaTerminos) {
+            char* fin = copiarConSignosEspaciados(termino, t.escribirTexto(termino, numVariables),
+                                                  expandido, primero);
+            resultado.append(expandido, fin - expandido);
+        }
+        return resultado;
+    }
+};
+
+// ------------------------------------------------
+// Lee un polinomio en varias variables ("3x^2y - 2xz^3 + 7").
+// Las letras válidas son las primeras 'variables' de "xyzuvwst".
+// ------------------------------------------------
+bool leerPolinomioMulti(string_view texto, int variables, CPolinomioMulti& destino,
+                        ErrorLectura* error = nullptr) {
+    const char* inicio = texto.data();
+    const char* p = inicio;
+    const char* fin = inicio + texto.size();
+    auto fallar = [&](const char* donde, const char* mensaje) {
+        if (error) {
+            error->posicion = donde - inicio;
+            error->mensaje = mensaje;
+        }
+        return false;
+    };
+    auto saltarEspacios = [&] {
+        while (p < fin && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) ++p;
+    };
+    auto indiceVariable = [&](char c) {
+        for (int v = 0; v < variables && v < MAX_VARIABLES; ++v)
+            if (LETRAS_VARIABLES[v] == c) return v;
+        return -1;
+    };
+
+    vector<TerminoMulti> terminos;
+    saltarEspacios();
+    if (p == fin)
+        return fallar(p, "texto vacío");
+
+    bool primero = true;
+    while (p < fin) {
+        double signo = 1;
+        if (*p == '+' || *p == '-') {
+            signo = *p == '-' ? -1 : 1;
+            ++p;
+            saltarEspacios();
+        } else if (!primero) {
+            return fallar(p, "se esperaba '+' o '-'");
+        }
+        primero = false;
+
+        const char* inicioTermino = p;
+        double coeficiente = 1;
+        bool hayCoeficiente = false;
+        if (p < fin && indiceVariable(*p) < 0) {
+            const char* siguiente = leerCoeficiente(p, fin, coeficiente);
+            if (!siguiente)
+                return fallar(p, "se esperaba un número o una variable");
+            p = siguiente;
+            hayCoeficiente = true;
+        }
+
+        int exponentes[MAX_VARIABLES] = {0};
+        bool hayVariable = false;
+        while (p < fin && indiceVariable(*p) >= 0) {
+            int v = indiceVariable(*p++);
+            int e = 1;
+            if (p < fin && *p == '^') {
+                ++p;
+                auto r = from_chars(p, fin, e);
+                if (r.ec != errc() || e < 0)
+                    return fallar(p, "exponente inválido");
+                p = r.ptr;
+            }
+            exponentes[v] += e;
+            if (exponentes[v] > MAX_EXPONENTE_MULTI)
+                return fallar(p, "exponente mayor que 127");
+            hayVariable = true;
+        }
+        if (!hayCoeficiente && !hayVariable)
+            return fallar(inicioTermino, "término vacío");
+
+        terminos.push_back({signo * coeficiente,
+                            empaquetarMonomio(vector<int>(exponentes, exponentes + MAX_VARIABLES))});
+        saltarEspacios();
+    }
+
+    destino = CPolinomioMulti::desdeTerminos(variables, move(terminos));
+    return true;
+}
+
+// ===================================================
+// Utilidades de benchmark (./eje_5 --bench)
+// ===================================================
+
+// Evita que el compilador elimine un resultado no usado
+volatile double sumideroBench = 0;
+
+// Mejor tiempo (en segundos) de varias repeticiones
+template <typename Funcion>
+double medirSegundos(Funcion funcion, int repeticiones = 3) {
+    double mejor = 1e300;
+    for (int r = 0; r < repeticiones; ++r) {
+        auto t0 = chrono::steady_clock::now();
+        funcion();
+        auto t1 = chrono::steady_clock::now();
+        mejor = min(mejor, chrono::duration<double>(t1 - t0).count());
+    }
+    return mejor;
+}
+
+// Términos aleatorios con exponentes en [0, 2n): hay repetidos y desorden
+vector<CTermino> terminosAleatorios(size_t n, unsigned semilla) {
+    mt19937 generador(semilla);
+    uniform_int_distribution<int> exponente(0, (int)(2 * n));
+    uniform_int_distribution<int> coeficiente(-9, 9);
+    vector<CTermino> terminos;
+    terminos.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+        terminos.emplace_back(coeficiente(generador), exponente(generador));
+    return terminos;
+}
+
+// ------------------------------------------------
+// Inserción original: busca lineal + sort + remove_if en cada término
+// (se reproduce aquí solo como referencia de costo)
+// ------------------------------------------------
+void insertarTerminoOriginal(vector<CTermino>& lista, const CTermino& nuevo) {
+    if (nuevo.leerCoef() == 0)
+        return;
+    bool encontrado = false;
+    for (auto& t : lista)
+        if (t.compararExp(nuevo)) { t.unir(nuevo); encontrado = true; break; }
+    if (!encontrado)
+        lista.push_back(nuevo);
+    sort(lista.begin(), lista.end(),
+         [](const CTermino& a, const CTermino& b) { return a.leerExp() < b.leerExp(); });
+    lista.erase(remove_if(lista.begin(), lista.end(),
+                          [](const CTermino& t) { return t.leerCoef() == 0; }),
+                lista.end());
+}
+
+// ------------------------------------------------
+// Construcción de polinomios de 10^5 a 10^7 términos
+// ------------------------------------------------
+void benchConstruccion() {
+    cout << "=== BENCH construcción de CPolinomio ===" << endl;
+    cout << setw(10) << "n" << setw(16) << "original (s)" << setw(18) << "insertarTermino"
+         << setw(16) << "desdeTerminos" << setw(12) << "términos" << endl;
+
+    for (size_t n : {10000u, 100000u, 1000000u, 10000000u}) {
+        vector<CTermino> entrada = terminosAleatorios(n, 42);
+
+        string original = "-";
+        if (n <= 10000) {
+            double t = medirSegundos([&] {
+                vector<CTermino> lista;
+                for (const auto& t : entrada) insertarTerminoOriginal(lista, t);
+            }, 1);
+            original = to_string(t);
+        }
+
+        int totalUno = 0, totalBloque = 0;
+        double tUno = medirSegundos([&] {
+            CPolinomio p;
+            for (const auto& t : entrada) p.insertarTermino(t);
+            totalUno = p.totalTerminos();
+        }, 1);
+        double tBloque = medirSegundos([&] {
+            totalBloque = CPolinomio::desdeTerminos(entrada).totalTerminos();
+        }, 1);
+
+        cout << setw(10) << n << setw(16) << original << setw(18) << tUno
+             << setw(16) << tBloque << setw(12) << totalBloque
+             << (totalUno == totalBloque ? "" : "  (DIFERENCIA)") << endl;
+    }
+    cout << endl;
+}
+
+// ------------------------------------------------
+// Polinomio disperso con 'n' términos y exponentes distintos en [0, rango)
+// ------------------------------------------------
+CPolinomio polinomioAleatorio(size_t n, int rango, unsigned semilla) {
+    mt19937 generador(semilla);
+    uniform_int_distribution<int> exponente(0, rango - 1);
+    uniform_int_distribution<int> coeficiente(1, 9);
+    vector<CTermino> terminos;
+    for (size_t i = 0; i < n; ++i)
+        terminos.emplace_back(coeficiente(generador), exponente(generador));
+    return CPolinomio::desdeTerminos(terminos);
+}
+
+// Compara dos polinomios término a término (exponente y coeficiente exactos)
+bool mismosTerminos(const CPolinomio& p, const CPolinomio& q) {
+    const vector<CTermino>& a = p.terminos();
+    const vector<CTermino>& b = q.terminos();
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (a[i].leerExp() != b[i].leerExp() || a[i].leerCoef() != b[i].leerCoef())
+            return false;
+    return true;
+}
+
+// ------------------------------------------------
+// Multiplicación: inserción término a término vs heap vs hash
+// ------------------------------------------------
+void benchMultiplicacion() {
+    cout << "=== BENCH multiplicación de CPolinomio ===" << endl;
+    cout << setw(26) << "caso" << setw(12) << "inserción" << setw(10) << "heap"
+         << setw(10) << "hash" << setw(12) << "automático" << setw(12) << "términos" << endl;
+
+    struct Caso { const char* nombre; size_t n; int rango; };
+    Caso casos[] = {
+        {"disperso 2000x2000", 2000, 1 << 30},
+        {"denso-ish 2000x2000", 2000, 8000},
+        {"disperso 4000x4000", 4000, 1 << 30},
+        {"denso-ish 20000x20000", 20000, 60000},
+    };
+
+    for (const auto& caso : casos) {
+        CPolinomio p = polinomioAleatorio(caso.n, caso.rango, 1);
+        CPolinomio q = polinomioAleatorio(caso.n, caso.rango, 2);
+
+        string insercion = "-";
+        if (caso.n <= 2000) {
+            double t = medirSegundos([&] {
+                CPolinomio r;
+                for (const auto& a : p.terminos())
+                    for (const auto& b : q.terminos())
+                        r.insertarTermino(a.producto(b));
+                r.totalTerminos();
+            }, 1);
+            insercion = to_string(t).substr(0, 6);
+        }
+
+        CPolinomio rHeap, rHash, rAuto;
+        // El heap en el caso denso grande tarda demasiado y no aporta
+        string heap = "-";
+        if (caso.n <= 4000)
+            heap = to_string(medirSegundos([&] { rHeap = p.multiplicar(q, ModoMultiplicacion::Heap); }, 1)).substr(0, 6);
+        double tHash = medirSegundos([&] { rHash = p.multiplicar(q, ModoMultiplicacion::Hash); }, 1);
+        double tAuto = medirSegundos([&] { rAuto = p.multiplicar(q); }, 1);
+
+        cout << setw(26) << caso.nombre << setw(12) << insercion << setw(10) << heap
+             << setw(10) << tHash << setw(12) << tAuto << setw(12) << rAuto.totalTerminos()
+             << (caso.n > 4000 || mismosTerminos(rHeap, rHash) ? "" : "  (DIFERENCIA heap/hash)") << endl;
+    }
+    cout << endl;
+}
+
+// ------------------------------------------------
+// Escalado de multiplicarParalelo de 1 a N hilos
+// ------------------------------------------------
+void benchMultiplicacionParalela() {
+    cout << "=== BENCH multiplicación paralela ===" << endl;
+    cout << "hilos disponibles: " << max(1u, thread::hardware_concurrency()) << endl;
+
+    struct Caso { const char* nombre; size_t n; int rango; };
+    Caso casos[] = {
+        {"disperso 3000x3000 (heap)", 3000, 1 << 30},
+        {"denso-ish 20000x20000 (hash)", 20000, 60000},
+    };
+    unsigned maxHilos = max(4u, thread::hardware_concurrency());
+
+    for (const auto& caso : casos) {
+        CPolinomio p = polinomioAleatorio(caso.n, caso.rango, 3);
+        CPolinomio q = polinomioAleatorio(caso.n, caso.rango, 4);
+        CPolinomio serial;
+        double tSerial = medirSegundos([&] { serial = p.multiplicar(q); }, 1);
+        cout << caso.nombre << ": serial " << tSerial << " s" << endl;
+
+        for (unsigned h = 1; h <= maxHilos; h *= 2) {
+            CPolinomio r;
+            double t = medirSegundos([&] { r = p.multiplicarParalelo(q, h); }, 1);
+            cout << setw(6) << h << " hilos: " << t << " s, aceleración "
+                 << setprecision(2) << tSerial / t << "x" << setprecision(4)
+                 << (mismosTerminos(serial, r) ? ", idéntico al serial" : ", DIFERENTE") << endl;
+        }
+    }
+    cout << endl;
+}
+
+// ------------------------------------------------
+// Formato original (stringstream por término y reconstrucción carácter a
+// carácter), reproducido para comprobar que el texto no cambió
+// ------------------------------------------------
+string terminoATextoOriginal(const CTermino& t) {
+    stringstream salidaTxt;
+    if (t.leerCoef() == 0)
+        return "";
+    salidaTxt << (t.leerCoef() > 0 ? "+" : "-");
+    double valorAbs = abs(t.leerCoef());
+    if (valorAbs != 1 || t.leerExp() == 0)
+        salidaTxt << valorAbs;
+    if (t.leerExp() > 0) {
+        salidaTxt << "x";
+        if (t.leerExp() > 1)
+            salidaTxt << "^" << t.leerExp();
+    }
+    return salidaTxt.str();
+}
+
+string aTextoOriginal(const CPolinomio& p) {
+    if (p.terminos().empty())
+        return "0";
+    stringstream salidaTxt;
+    for (const auto& t : p.terminos())
+        salidaTxt << terminoATextoOriginal(t);
+    string texto = salidaTxt.str();
+    if (texto[0] == '+')
+        texto.erase(0, 1);
+    string resultado;
+    for (size_t i = 0; i < texto.size(); ++i) {
+        if (texto[i] == '+' || texto[i] == '-')
+            resultado += " " + string(1, texto[i]) + " ";
+        else
+            resultado += texto[i];
+    }
+    return resultado;
+}
+
+// ------------------------------------------------
+// Serialización: formato original vs búfer único vs descriptor
+// ------------------------------------------------
+void benchTexto() {
+    cout << "=== BENCH serialización a texto ===" << endl;
+
+    // Coeficientes variados: enteros, decimales, ±1, notación científica
+    mt19937 generador(5);
+    uniform_real_distribution<double> real(-1000.0, 1000.0);
+    uniform_int_distribution<int> tipo(0, 4);
+    auto coeficienteVariado = [&]() -> double {
+        switch (tipo(generador)) {
+            case 0: return (int)real(generador);
+            case 1: return real(generador);
+            case 2: return real(generador) > 0 ? 1 : -1;
+            case 3: return real(generador) * 1e-9;
+            default: return real(generador) * 1e7;
+        }
+    };
+
+    for (size_t n : {100000u, 1000000u}) {
+        vector<CTermino> terminos;
+        for (size_t i = 0; i < n; ++i)
+            terminos.emplace_back(coeficienteVariado(), (int)i);
+        CPolinomio p = CPolinomio::desdeTerminos(terminos);
+
+        string original, nuevo;
+        double tOriginal = medirSegundos([&] { original = aTextoOriginal(p); }, 1);
+        double tNuevo = medirSegundos([&] { nuevo = p.aTexto(); });
+
+        FILE* nulo = fopen("/dev/null", "w");
+        double tDescriptor = nulo ? medirSegundos([&] { p.escribirEnDescriptor(fileno(nulo)); }) : 0;
+        if (nulo) fclose(nulo);
+
+        cout << setw(9) << n << " términos: original " << tOriginal << " s, búfer único "
+             << tNuevo << " s (" << setprecision(1) << original.size() / tNuevo / 1e6
+             << " MB/s), descriptor " << setprecision(4) << tDescriptor << " s, "
+             << (original == nuevo ? "texto idéntico" : "TEXTO DISTINTO") << endl;
+    }
+    cout << endl;
+}
+
+// ------------------------------------------------
+// Lectura desde texto y desde archivo mapeado
+// ------------------------------------------------
+void benchLectura() {
+    cout << "=== BENCH lectura de texto ===" << endl;
+
+    mt19937 generador(9);
+    uniform_real_distribution<double> real(-1000.0, 1000.0);
+    vector<CTermino> terminos;
+    for (int i = 0; i < 2000000; ++i)
+        terminos.emplace_back(i % 3 == 0 ? (int)real(generador) : real(generador) * (i % 7 == 0 ? 1e-9 : 1), 3 * i);
+    CPolinomio p = CPolinomio::desdeTerminos(terminos);
+    string texto = p.aTexto();
+
+    CPolinomio leido;
+    bool correcto = true;
+    double tTexto = medirSegundos([&] { correcto = correcto && leerPolinomio(texto, leido); });
+    cout << "texto de " << texto.size() / 1e6 << " MB: " << tTexto << " s, "
+         << setprecision(1) << texto.size() / tTexto / 1e6 << " MB/s" << setprecision(4)
+         << (correcto && leido.aTexto() == texto ? ", ida y vuelta idéntica" : ", ERROR en ida y vuelta") << endl;
+
+    const char* ruta = "bench_polinomio.txt";
+    FILE* archivo = fopen(ruta, "wb");
+    if (archivo) {
+        p.escribirEnDescriptor(fileno(archivo));
+        fclose(archivo);
+        double tArchivo = medirSegundos([&] { correcto = leerPolinomioDeArchivo(ruta, leido); });
+        cout << "archivo mapeado: " << tArchivo << " s, " << setprecision(1)
+             << texto.size() / tArchivo / 1e6 << " MB/s" << setprecision(4)
+             << (correcto ? "" : " (ERROR)") << endl;
+        remove(ruta);
+    }
+
+    ErrorLectura error;
+    string malo = "3x^2 + + 4";
+    if (!leerPolinomio(malo, leido, &error))
+        cout << "\"" << malo << "\" -> error en la posición " << error.posicion
+             << ": " << error.mensaje << endl;
+    cout << endl;
+}
+
+// ------------------------------------------------
+// Representación densa vs dispersa con los mismos polinomios
+// ------------------------------------------------
+void benchRepresentacion() {
+    cout << "=== BENCH representación densa / dispersa ===" << endl;
+
+    for (size_t n : {2000u, 20000u}) {
+        // Ocupación ~63 %: desdeTerminos los deja en forma densa
+        CPolinomio densoA = polinomioAleatorio(n, (int)n, 11);
+        CPolinomio densoB = polinomioAleatorio(n, (int)n, 12);
+        CPolinomio dispersoA = densoA, dispersoB = densoB;
+        dispersoA.convertirADisperso();
+        dispersoB.convertirADisperso();
+
+        CPolinomio sumaDensa, sumaDispersa, productoDenso, productoDisperso;
+        string textoDenso, textoDisperso;
+        double tSumaDensa = medirSegundos([&] { sumaDensa = densoA.sumar(densoB); });
+        double tSumaDispersa = medirSegundos([&] {
+            sumaDispersa = dispersoA.sumar(dispersoB);
+            sumaDispersa.convertirADisperso();
+        });
+        double tProdDenso = medirSegundos([&] { productoDenso = densoA.multiplicar(densoB); });
+        double tProdDisperso = medirSegundos([&] {
+            productoDisperso = dispersoA.multiplicar(dispersoB);
+        });
+        double tTextoDenso = medirSegundos([&] { textoDenso = densoA.aTexto(); });
+        double tTextoDisperso = medirSegundos([&] { textoDisperso = dispersoA.aTexto(); });
+
+        // Disperso × denso: un polinomio con pocos términos por uno denso
+        CPolinomio pocos = CPolinomio::desdeTerminos({{2, 0}, {-1, 7}, {3, (int)n / 2}});
+        CPolinomio mixto, mixtoDisperso;
+        double tMixto = medirSegundos([&] { mixto = pocos.multiplicar(densoA); });
+        double tMixtoDisperso = medirSegundos([&] {
+            mixtoDisperso = pocos.multiplicar(dispersoA, ModoMultiplicacion::Hash);
+        });
+
+        bool iguales = mismosTerminos(sumaDensa, sumaDispersa) &&
+                       mismosTerminos(productoDenso, productoDisperso) &&
+                       mismosTerminos(mixto, mixtoDisperso) && textoDenso == textoDisperso;
+
+        cout << n << " términos (denso: " << (densoA.representacionDensa() ? "sí" : "no") << ", "
+             << densoA.totalTerminos() << " no nulos), disperso -> denso en ms: sumar "
+             << tSumaDispersa * 1e3 << " -> " << tSumaDensa * 1e3 << ", multiplicar "
+             << tProdDisperso * 1e3 << " -> " << tProdDenso * 1e3 << ", disperso×denso "
+             << tMixtoDisperso * 1e3 << " -> " << tMixto * 1e3 << ", aTexto "
+             << tTextoDisperso * 1e3 << " -> " << tTextoDenso * 1e3 << ", "
+             << (iguales ? "resultados idénticos" : "RESULTADOS DISTINTOS") << endl;
+    }
+    cout << endl;
+}
+
+// ------------------------------------------------
+// División larga "a mano": un término del cociente por vuelta con
+// insertarTermino, multiplicar y sumar (referencia de costo)
+// ------------------------------------------------
+void dividirIngenuo(const CPolinomio& f, const CPolinomio& g, CPolinomio& cociente, CPolinomio& residuo) {
+    const CTermino principal = g.terminos().back();
+    CPolinomio resto = f;
+    cociente = CPolinomio();
+    residuo = CPolinomio();
+    while (resto.totalTerminos() > 0) {
+        CTermino mayor = resto.terminos().back();
+        if (mayor.leerExp() < principal.leerExp())
+            break;
+        CTermino paso(mayor.leerCoef() / principal.leerCoef(), mayor.leerExp() - principal.leerExp());
+        cociente.insertarTermino(paso);
+        CPolinomio monomio;
+        monomio.insertarTermino(CTermino(-paso.leerCoef(), paso.leerExp()));
+        CPolinomio nuevoResto = resto.sumar(g.multiplicar(monomio));
+        // El término principal se cancela exactamente, como en la división a mano
+        vector<CTermino> sinPrincipal;
+        for (const auto& t : nuevoResto.terminos())
+            if (t.leerExp() != mayor.leerExp()) sinPrincipal.push_back(t);
+        resto = CPolinomio::desdeTerminos(move(sinPrincipal));
+    }
+    residuo = resto;
+}
+
+// Mayor diferencia entre coeficientes de igual exponente, relativa al mayor coeficiente
+double diferenciaRelativa(const CPolinomio& p, const CPolinomio& q) {
+    map<int, double> diferencia;
+    double escala = 1e-300;
+    for (const auto& t : p.terminos()) { diferencia[t.leerExp()] += t.leerCoef(); escala = max(escala, fabs(t.leerCoef())); }
+    for (const auto& t : q.terminos()) { diferencia[t.leerExp()] -= t.leerCoef(); escala = max(escala, fabs(t.leerCoef())); }
+    double maximo = 0;
+    for (const auto& par : diferencia) maximo = max(maximo, fabs(par.second));
+    return maximo / escala;
+}
+
+// Polinomio denso de grado n-1 cuyo coeficiente principal domina a los
+// demás, para que la división sea numéricamente estable
+CPolinomio divisorEstable(size_t n, unsigned semilla) {
+    mt19937 generador(semilla);
+    uniform_int_distribution<int> coeficiente(-9, 9);
+    vector<CTermino> t;
+    double suma = 0;
+    for (size_t k = 0; k + 1 < n; ++k) {
+        double c = coeficiente(generador);
+        suma += fabs(c);
+        t.emplace_back(c, (int)k);
+    }
+    t.emplace_back(suma + 1, (int)n - 1);
+    return CPolinomio::desdeTerminos(t);
+}
+
+// ------------------------------------------------
+// División y MCD: núcleos nuevos vs división larga a mano
+// ------------------------------------------------
+void benchDivisionPolinomios() {
+    cout << "=== BENCH división y MCD de CPolinomio ===" << endl;
+
+    struct Caso { const char* nombre; CPolinomio divisor, cociente, resto; bool conDispersa; };
+    vector<Caso> casos;
+    {
+        CPolinomio g, q, r;
+        leerPolinomio("5 - x^7 + x^30000", g);
+        leerPolinomio("-2 + 3x^1000 + x^20000 + 4x^50000", q);
+        leerPolinomio("1 + x^5", r);
+        casos.push_back({"disperso (grado 80000)", g, q, r, true});
+    }
+    casos.push_back({"denso 2000 / 1000", divisorEstable(1000, 1), polinomioAleatorio(4000, 1001, 2),
+                     polinomioAleatorio(2000, 999, 3), true});
+    casos.push_back({"denso 20000 / 10000", divisorEstable(10000, 4), polinomioAleatorio(40000, 10001, 5),
+                     polinomioAleatorio(20000, 9999, 6), false});
+
+    for (auto& caso : casos) {
+        CPolinomio f = caso.divisor.multiplicar(caso.cociente).sumar(caso.resto);
+        cout << caso.nombre << " (" << f.totalTerminos() << " / " << caso.divisor.totalTerminos()
+             << " términos):" << endl;
+
+        {
+            CPolinomio q, r;
+            double t = medirSegundos([&] { dividirIngenuo(f, caso.divisor, q, r); }, 1);
+            cout << setw(14) << "a mano" << ": " << t << " s, error del cociente "
+                 << scientific << setprecision(1) << diferenciaRelativa(q, caso.cociente)
+                 << fixed << setprecision(4) << endl;
+        }
+        struct Modo { const char* nombre; ModoDivision modo; };
+        for (Modo m : {Modo{"dispersa", ModoDivision::Dispersa}, Modo{"densa", ModoDivision::Densa},
+                       Modo{"Newton", ModoDivision::Newton}, Modo{"automático", ModoDivision::Automatico}}) {
+            if (m.modo == ModoDivision::Dispersa && !caso.conDispersa)
+                continue;  // Sobre 10^4 × 10^4 productos densos el montículo tarda segundos
+            CPolinomio q, r;
+            double t = medirSegundos([&] { f.dividir(caso.divisor, q, r, m.modo); }, 1);
+            cout << setw(14) << m.nombre << ": " << t << " s, error del cociente "
+                 << scientific << setprecision(1) << diferenciaRelativa(q, caso.cociente)
+                 << ", del resto " << diferenciaRelativa(r, caso.resto) << fixed << setprecision(4) << endl;
+        }
+    }
+
+    // MCD de dos polinomios enteros con un factor común de grado 100
+    mt19937 generador(9);
+    uniform_int_distribution<int> coeficiente(-5, 5);
+    auto enteroAleatorio = [&](int grado) {
+        vector<CTermino> t;
+        for (int k = 0; k < grado; ++k) t.emplace_back(coeficiente(generador), k);
+        t.emplace_back(1 + abs(coeficiente(generador)), grado);
+        return CPolinomio::desdeTerminos(t);
+    };
+    CPolinomio comun = enteroAleatorio(100);
+    CPolinomio a = comun.multiplicar(enteroAleatorio(200)), b = comun.multiplicar(enteroAleatorio(150));
+
+    // Euclides en punto flotante con la división a mano
+    CPolinomio mcdFlotante;
+    double tFlotante = medirSegundos([&] {
+        CPolinomio x = a, y = b;
+        while (y.totalTerminos() > 0) {
+            CPolinomio q, r;
+            dividirIngenuo(x, y, q, r);
+            vector<CTermino> limpio;
+            double mayor = 0;
+            for (const auto& t : y.terminos()) mayor = max(mayor, fabs(t.leerCoef()));
+            for (const auto& t : r.terminos())
+                if (fabs(t.leerCoef()) > 1e-9 * mayor) limpio.push_back(t);
+            x = y;
+            y = CPolinomio::desdeTerminos(limpio);
+        }
+        mcdFlotante = x;
+    }, 1);
+    CPolinomio mcdExacto;
+    double tModular = medirSegundos([&] { a.mcdModular(b, mcdExacto); });
+    int gradoFlotante = mcdFlotante.totalTerminos() ? mcdFlotante.terminos().back().leerExp() : -1;
+    cout << "MCD grado 300 / 250 con factor común de grado 100: Euclides a mano " << tFlotante * 1e3
+         << " ms (grado " << gradoFlotante << "), modular " << tModular * 1e3 << " ms (grado "
+         << mcdExacto.terminos().back().leerExp() << ", "
+         << (mismosTerminos(mcdExacto, comun) ? "igual al factor común" : "DISTINTO del factor común")
+         << ")" << endl << endl;
+}
+
+// ------------------------------------------------
+// Evaluación: pow por término vs cuadrados sucesivos, punto a punto y en lote
+// ------------------------------------------------
+void benchEvaluacion() {
+    cout << "=== BENCH evaluación de CPolinomio ===" << endl;
+
+    // Puntos en [-1, 1] para que las potencias altas no desborden
+    const size_t PUNTOS = 1 << 14;
+    vector<double> puntos(PUNTOS);
+    mt19937 generador(5);
+    uniform_real_distribution<double> valor(-1.0, 1.0);
+    for (double& x : puntos) x = valor(generador);
+
+    struct Caso { const char* nombre; CPolinomio poli; };
+    vector<Caso> casos;
+    casos.push_back({"x^100000 + 1", CPolinomio::desdeTerminos({{1, 0}, {1, 100000}})});
+    casos.push_back({"1000 términos, grado ~10^6", polinomioAleatorio(1000, 1000000, 3)});
+    casos.push_back({"denso, grado 1000", polinomioAleatorio(20000, 1000, 4)});
+
+    for (auto& caso : casos) {
+        const vector<CTermino>& lista = caso.poli.terminos();
+        vector<double> porPow(PUNTOS), punto(PUNTOS), lote(PUNTOS);
+
+        // Referencia: pow(x, e) independiente para cada término
+        double tPow = medirSegundos([&] {
+            for (size_t i = 0; i < PUNTOS; ++i) {
+                double total = 0;
+                for (const auto& t : lista) total += t.leerCoef() * pow(puntos[i], t.leerExp());
+                porPow[i] = total;
+            }
+        });
+        double tPunto = medirSegundos([&] {
+            for (size_t i = 0; i < PUNTOS; ++i) punto[i] = caso.poli.evaluar(puntos[i]);
+        });
+        double tLote = medirSegundos([&] { caso.poli.evaluarLote(puntos.data(), lote.data(), PUNTOS); });
+
+        // Diferencia relativa máxima frente a pow (el redondeo de las potencias difiere)
+        double error = 0;
+        for (size_t i = 0; i < PUNTOS; ++i)
+            error = max(error, fabs(punto[i] - porPow[i]) / max(1.0, fabs(porPow[i])));
+
+        cout << caso.nombre << " (" << lista.size() << " términos, " << PUNTOS << " puntos): pow "
+             << tPow << " s, evaluar " << tPunto << " s, evaluarLote " << tLote << " s ("
+             << setprecision(1) << tPow / tLote << "x), error rel. " << scientific << error
+             << fixed << setprecision(4) << ", lote " << (punto == lote ? "idéntico" : "DISTINTO")
+             << " a evaluar" << endl;
+    }
+    cout << endl;
+}
+
+// ------------------------------------------------
+// Multivariable: monomios empaquetados vs map<vector<int>, double>
+// ------------------------------------------------
+void benchMultivariable() {
+    cout << "=== BENCH polinomios en varias variables ===" << endl;
+
+    struct Caso { const char* nombre; int variables; int maxExp; int terminos; };
+    Caso casos[] = {
+        {"3 variables, grado <= 20 por variable", 3, 20, 1500},
+        {"6 variables, grado <= 10 por variable", 6, 10, 1500},
+    };
+
+    for (const auto& caso : casos) {
+        mt19937 generador(17);
+        uniform_int_distribution<int> exponente(0, caso.maxExp);
+        uniform_int_distribution<int> coeficiente(-9, 9);
+
+        // Mismos términos para ambas representaciones
+        vector<pair<vector<int>, double>> crudosA, crudosB;
+        for (auto* crudos : {&crudosA, &crudosB})
+            for (int i = 0; i < caso.terminos; ++i) {
+                vector<int> e(caso.variables);
+                for (int& x : e) x = exponente(generador);
+                crudos->push_back({e, (double)coeficiente(generador)});
+            }
+
+        auto aMapa = [](const vector<pair<vector<int>, double>>& crudos) {
+            map<vector<int>, double> m;
+            for (const auto& t : crudos) m[t.first] += t.second;
+            for (auto it = m.begin(); it != m.end();) it = it->second == 0 ? m.erase(it) : next(it);
+            return m;
+        };
+        auto aEmpaquetado = [&](const vector<pair<vector<int>, double>>& crudos) {
+            vector<TerminoMulti> t;
+            for (const auto& c : crudos) t.push_back({c.second, empaquetarMonomio(c.first)});
+            return CPolinomioMulti::desdeTerminos(caso.variables, t);
+        };
+        map<vector<int>, double> mapaA = aMapa(crudosA), mapaB = aMapa(crudosB);
+        CPolinomioMulti a = aEmpaquetado(crudosA), b = aEmpaquetado(crudosB);
+
+        // Producto ingenuo con map: suma de vectores de exponentes y búsqueda en árbol
+        map<vector<int>, double> productoMapa;
+        double tMapa = medirSegundos([&] {
+            productoMapa.clear();
+            vector<int> e(caso.variables);
+            for (const auto& x : mapaA)
+                for (const auto& y : mapaB) {
+                    for (int v = 0; v < caso.variables; ++v) e[v] = x.first[v] + y.first[v];
+                    productoMapa[e] += x.second * y.second;
+                }
+            for (auto it = productoMapa.begin(); it != productoMapa.end();)
+                it = it->second == 0 ? productoMapa.erase(it) : next(it);
+        }, 1);
+
+        CPolinomioMulti producto;
+        double tEmpaquetado = medirSegundos([&] { a.multiplicar(b, producto); }, 1);
+
+        // Comparación exacta término a término
+        bool iguales = (size_t)producto.totalTerminos() == productoMapa.size();
+        size_t k = 0;
+        for (const auto& par : productoMapa) {
+            if (!iguales) break;
+            const TerminoMulti& t = producto.terminos()[k++];
+            iguales = t.monomio == empaquetarMonomio(par.first) && t.coef == par.second;
+        }
+
+        vector<double> punto(caso.variables, 0.99);
+        double tEvaluar = medirSegundos([&] { sumideroBench = sumideroBench + producto.evaluar(punto); });
+
+        cout << caso.nombre << ": map " << tMapa << " s, empaquetado " << tEmpaquetado
+             << " s (" << setprecision(1) << tMapa / tEmpaquetado << "x)" << setprecision(4)
+             << ", " << producto.totalTerminos() << " términos, evaluar " << tEvaluar * 1e3 << " ms, "
+             << (iguales ? "resultados idénticos" : "RESULTADOS DISTINTOS") << endl;
+    }
+
+    CPolinomioMulti ejemplo(3);
+    leerPolinomioMulti("3x^2y - 2xz^3 + 7", 3, ejemplo);
+    CPolinomioMulti cuadrado;
+    ejemplo.multiplicar(ejemplo, cuadrado);
+    cout << "(" << ejemplo.aTexto() << ")^2 = " << cuadrado.aTexto() << endl << endl;
+}
+
+// ===================================================
+// Pruebas de regresión: ./eje_5 --pruebas
+// Casos límite que el benchmark no cubre. Cada comprobación informa OK o
+// FALLA y el programa termina con código 1 si alguna falló.
+// ===================================================
+int pruebasFallidas = 0;
+
+void comprobar(bool condicion, const string& descripcion) {
+    cout << (condicion ? "  OK    " : "  FALLA ") << descripcion << endl;
+    if (!condicion) pruebasFallidas++;
+}
+
+// ------------------------------------------------
+// Acumulador hash con más exponentes distintos que su tabla: debe pasar
+// al heap en lugar de sondear para siempre en una tabla llena
+// ------------------------------------------------
+void pruebaHashSinLugar() {
+    cout << "=== PRUEBA acumulador hash sin lugar en la tabla ===" << endl;
+    vector<CTermino> filas, columnas;
+    for (int i = 0; i < 64; ++i) {
+        filas.emplace_back(i + 1, i);
+        columnas.emplace_back(2 * i + 1, 1000 * i);
+    }
+    // 4096 productos con exponentes distintos y una tabla de 1024 entradas
+    vector<CTermino> conHash, conHeap;
+    multiplicarConHash(filas, columnas, 0, 64000, conHash, 1024);
+    multiplicarConHeap(filas, columnas, 0, 64000, conHeap);
+    bool iguales = conHash.size() == conHeap.size();
+    for (size_t i = 0; iguales && i < conHash.size(); ++i)
+        iguales = conHash[i].leerExp() == conHeap[i].leerExp() && conHash[i].leerCoef() == conHeap[i].leerCoef();
+    comprobar(conHash.size() == 4096 && iguales, "4096 exponentes distintos con tabla de 1024: mismo resultado que el heap");
+    cout << endl;
+}
+
+// ------------------------------------------------
+// CPolinomioMulti: exponentes fuera de rango al insertar y desborde del
+// producto (detectado por los bits de guarda, no un polinomio nulo)
+// ------------------------------------------------
+void pruebaMultiDesborde() {
+    cout << "=== PRUEBA exponentes y desborde de CPolinomioMulti ===" << endl;
+    CPolinomioMulti p(2);
+    comprobar(p.insertarTermino(3, {127, 1}), "acepta x^127 y");
+    comprobar(!p.insertarTermino(1, {128, 0}), "rechaza x^128");
+    comprobar(!p.insertarTermino(1, {-1, 2}), "rechaza exponentes negativos");
+    comprobar(!p.insertarTermino(1, {1, 0, 4}), "rechaza una variable que el polinomio no tiene");
+    comprobar(p.totalTerminos() == 1, "los términos rechazados no se insertan");
+
+    CPolinomioMulti a(2), b(2), producto(2);
+    a.insertarTermino(2, {100, 5});
+    b.insertarTermino(3, {27, 0});
+    bool cabe = a.multiplicar(b, producto);
+    comprobar(cabe && producto.totalTerminos() == 1 && producto.terminos()[0].monomio == empaquetarMonomio({127, 5}) &&
+              producto.terminos()[0].coef == 6, "x^100 y^5 · x^27 = x^127 y^5");
+    b.insertarTermino(1, {0, 123});
+    comprobar(!a.multiplicar(b, producto) && producto.totalTerminos() == 0, "y^5 · y^123 informa desborde");
+    CPolinomioMulti nulo(2);
+    comprobar(a.multiplicar(nulo, producto) && producto.totalTerminos() == 0, "el producto por cero no es un desborde");
+    cout << endl;
+}
+
+// ------------------------------------------------
+// mcdModular con un factor común de coeficientes cercanos a 2^40: el
+// MCD escalado por gamma pasa de 2^80 y necesita más de dos primos
+// ------------------------------------------------
+void pruebaMcdGrande() {
+    cout << "=== PRUEBA mcdModular con coeficientes grandes ===" << endl;
+    CPolinomio comun = CPolinomio::desdeTerminos({CTermino(-987654321987.0, 0), CTermino(1, 1),
+                                                  CTermino(1234567890123.0, 2)});
+    CPolinomio a = comun.multiplicar(CPolinomio::desdeTerminos({CTermino(1, 0), CTermino(1, 1)}));
+    CPolinomio b = comun.multiplicar(CPolinomio::desdeTerminos({CTermino(3, 0), CTermino(2, 2)}));
+    CPolinomio g;
+    comprobar(a.mcdModular(b, g) && mismosTerminos(g, comun), "mcd = 1234567890123x^2 + x - 987654321987");
+    CPolinomio negado = comun.multiplicar(CPolinomio::desdeTerminos({CTermino(-5, 0)}));
+    comprobar(negado.mcdModular(b, g) && mismosTerminos(g, comun), "el signo y el contenido no alteran el resultado");
+    CPolinomio c = CPolinomio::desdeTerminos({CTermino(-2, 0), CTermino(1, 1)});
+    comprobar(a.mcdModular(c, g) && mismosTerminos(g, CPolinomio::desdeTerminos({CTermino(1, 0)})),
+              "sin factor común el mcd es 1");
+    cout << endl;
+}
+
 // ===================================================
 // Bloque principal de ejecución del programa
 // ===================================================
-int main() {
+int main(int argc, char* argv[]) {
+    // Modo benchmark: ./eje_5 --bench
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        cout << fixed << setprecision(4);
+        benchConstruccion();
+        benchMultiplicacion();
+        benchMultiplicacionParalela();
+        benchTexto();
+        benchLectura();
+        benchRepresentacion();
+        benchDivisionPolinomios();
+        benchEvaluacion();
+        benchMultivariable();
+        return 0;
+    }
+
+    // Pruebas de regresión: ./eje_5 --pruebas
+    if (argc > 1 && string(argv[1]) == "--pruebas") {
+        pruebaHashSinLugar();
+        pruebaMultiDesborde();
+        pruebaMcdGrande();
+        cout << (pruebasFallidas == 0 ? "Todas las pruebas pasaron" : "Hay pruebas fallidas") << endl;
+        return pruebasFallidas == 0 ? 0 : 1;
+    }
+
     cout << fixed << setprecision(2);
 
     // ------------------------------------------------
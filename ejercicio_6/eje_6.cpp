@@ -1,6 +1,11 @@
 // Archivo: eje_6.cpp
 // Compilar: g++ -std=c++17 eje_6.cpp -o juego
 // Ejecutar: ./juego (Windows: juego.exe)
+// Benchmark del simulador sin consola: g++ -std=c++17 -O2 -pthread eje_6.cpp -o juego && ./juego --bench
+// Partida reproducible: ./juego --semilla 1234 (con --registro partidas.dlog se graba en binario)
+// Juegos grandes: ./juego --doble 9 (también 12 o 15)
+// Revisar un registro: ./juego --reproducir partidas.dlog
+// Servidor de mesas (Linux): ./juego --servidor 5555 y en otra consola ./juego --carga 5555 2000 10
 // Implementación orientada a objetos del juego de dominó (2-4 jugadores humanos)
 
 #include <iostream>
@@ -11,7 +16,40 @@
 #include <ctime>
 #include <string>
 #include <limits>
-#include <map>
+#include <climits>
+#include <cstdint>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <type_traits>
+#if !defined(_WIN32) && !defined(_WIN64)
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+#if defined(__linux__)
+    #include <cerrno>
+    #include <csignal>
+    #include <sys/epoll.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <sys/resource.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+#endif
 
 // === HABILITAR TILDES Y CARACTERES ESPECIALES EN CONSOLA (Windows + MinGW) ===
 #if defined(_WIN32) || defined(_WIN64)
@@ -26,6 +64,91 @@
 
 using namespace std;
 
+// =========================
+// Identificadores compactos de pieza y máscaras de bits
+// Las 28 piezas se numeran 0..27 en el mismo orden en que
+// generarConjuntoCompleto las crea ([0|0], [0|1], ..., [6|6]), así un
+// conjunto de piezas (una mano, el pozo, la mesa) cabe en un entero de
+// 32 bits: el bit i indica si la pieza i está presente.
+// =========================
+const int TOTAL_PIEZAS = 28;
+const int VALOR_MAXIMO = 6;
+const int PIEZAS_POR_MANO = 7;
+const int MAX_JUGADORES = 4;
+const uint32_t TODAS_LAS_PIEZAS = (1u << TOTAL_PIEZAS) - 1;
+
+// Juegos más grandes para PartidaDomino (doble nueve, doble doce, doble
+// quince: hasta 136 piezas). Las máscaras de 32 bits siguen siendo solo
+// del doble seis; para los demás la mano se indexa por valor.
+const int VALOR_MAXIMO_SOPORTADO = 15;
+const int MAX_PIEZAS_CONJUNTO = 136;  // piezasDelConjunto(VALOR_MAXIMO_SOPORTADO)
+
+// Piezas de un juego doble-N: (N + 1)(N + 2) / 2
+inline int piezasDelConjunto(int maximo) { return (maximo + 1) * (maximo + 2) / 2; }
+
+// Piezas por mano en cada juego (0 si el juego no está soportado)
+inline int piezasPorManoPara(int maximo) {
+    switch (maximo) {
+        case 6: return 7;
+        case 9: return 10;
+        case 12: return 12;
+        case 15: return 15;
+        default: return 0;
+    }
+}
+
+// Lados, puntos y valores presentes (un bit por valor) de cada pieza, y
+// por cada valor la máscara de las piezas que lo muestran: "¿tiene una
+// pieza para el extremo X?" es mano & mascaraValor[X]
+struct TablaPiezas {
+    uint8_t izquierdo[TOTAL_PIEZAS];
+    uint8_t derecho[TOTAL_PIEZAS];
+    uint8_t puntos[TOTAL_PIEZAS];
+    uint8_t valores[TOTAL_PIEZAS];
+    uint32_t mascaraValor[VALOR_MAXIMO + 1];
+    TablaPiezas() : mascaraValor() {
+        int id = 0;
+        for (int izq = 0; izq <= VALOR_MAXIMO; ++izq)
+            for (int der = izq; der <= VALOR_MAXIMO; ++der, ++id) {
+                izquierdo[id] = (uint8_t)izq;
+                derecho[id] = (uint8_t)der;
+                puntos[id] = (uint8_t)(izq + der);
+                valores[id] = (uint8_t)((1 << izq) | (1 << der));
+                mascaraValor[izq] |= 1u << id;
+                mascaraValor[der] |= 1u << id;
+            }
+    }
+};
+static const TablaPiezas tablaPiezas;
+
+// Cantidad de bits encendidos y posición del bit más bajo (mascara != 0)
+#if defined(_MSC_VER)
+    #include <intrin.h>
+    inline int contarBits(uint32_t mascara) { return (int)__popcnt(mascara); }
+    inline int bitMasBajo(uint32_t mascara) { unsigned long i; _BitScanForward(&i, mascara); return (int)i; }
+    inline int contarBits(uint64_t mascara) { return (int)__popcnt64(mascara); }
+    inline int bitMasBajo(uint64_t mascara) { unsigned long i; _BitScanForward64(&i, mascara); return (int)i; }
+    inline int bitMasAlto(uint64_t mascara) { unsigned long i; _BitScanReverse64(&i, mascara); return (int)i; }
+#else
+    inline int contarBits(uint32_t mascara) { return __builtin_popcount(mascara); }
+    inline int bitMasBajo(uint32_t mascara) { return __builtin_ctz(mascara); }
+    inline int contarBits(uint64_t mascara) { return __builtin_popcountll(mascara); }
+    inline int bitMasBajo(uint64_t mascara) { return __builtin_ctzll(mascara); }
+    inline int bitMasAlto(uint64_t mascara) { return 63 - __builtin_clzll(mascara); }
+#endif
+
+// Máscara de las piezas jugables en un extremo (-1: tablero vacío, todas)
+inline uint32_t jugablesEn(uint32_t mano, int extremo) {
+    return extremo < 0 ? mano : mano & tablaPiezas.mascaraValor[extremo];
+}
+
+// Suma de puntos de un conjunto de piezas
+inline int puntosDe(uint32_t piezas) {
+    int total = 0;
+    for (; piezas; piezas &= piezas - 1) total += tablaPiezas.puntos[bitMasBajo(piezas)];
+    return total;
+}
+
 // =========================
 // Clase PiezaDomino
 // Representa una pieza de dominó con dos valores (ladoIzquierdo, ladoDerecho).
@@ -58,8 +181,58 @@ public:
         return (ladoIzquierdo == otra.ladoIzquierdo && ladoDerecho == otra.ladoDerecho) ||
                (ladoIzquierdo == otra.ladoDerecho && ladoDerecho == otra.ladoIzquierdo);
     }
+
+    // Identificador sin importar la orientación: 0..27 en el doble seis,
+    // 0..(piezas - 1) en un juego doble-'maximo'
+    int identificador(int maximo = VALOR_MAXIMO) const {
+        int a = min(ladoIzquierdo, ladoDerecho), b = max(ladoIzquierdo, ladoDerecho);
+        // Antes de la fila 'a' hay (maximo + 1) + maximo + ... piezas
+        return a * (2 * (maximo + 1) - a + 1) / 2 + (b - a);
+    }
+
+    // Bit de la pieza dentro de una máscara de doble seis (0 si no es de ese juego)
+    uint32_t mascara() const {
+        return max(ladoIzquierdo, ladoDerecho) <= VALOR_MAXIMO ? 1u << identificador() : 0;
+    }
+
+    // Pieza a partir de su identificador
+    static PiezaDomino desdeIdentificador(int id) {
+        return PiezaDomino(tablaPiezas.izquierdo[id], tablaPiezas.derecho[id]);
+    }
+};
+
+// =========================
+// Clase MesaDomino
+// Piezas colocadas en la mesa, con las operaciones de deque que usa el
+// juego (push_front, push_back, front, back, recorrido). Es un arreglo
+// fijo que empieza en el centro y tiene lugar para el juego completo
+// hacia cualquiera de los dos lados: colocar piezas o vaciar la mesa
+// nunca pide memoria.
+// =========================
+class MesaDomino {
+private:
+    static const int CAPACIDAD = 2 * MAX_PIEZAS_CONJUNTO + 1;
+    PiezaDomino piezas[CAPACIDAD];
+    int inicio = CAPACIDAD / 2;  // Primera pieza
+    int fin = CAPACIDAD / 2;     // Una después de la última
+public:
+    bool empty() const { return inicio == fin; }
+    size_t size() const { return (size_t)(fin - inicio); }
+    void clear() { inicio = fin = CAPACIDAD / 2; }
+
+    // Coloca una pieza en el extremo izquierdo o derecho
+    void push_front(const PiezaDomino& p) { piezas[--inicio] = p; }
+    void push_back(const PiezaDomino& p) { piezas[fin++] = p; }
+
+    const PiezaDomino& front() const { return piezas[inicio]; }
+    const PiezaDomino& back() const { return piezas[fin - 1]; }
+    const PiezaDomino& operator[](size_t i) const { return piezas[inicio + i]; }
+    const PiezaDomino* begin() const { return piezas + inicio; }
+    const PiezaDomino* end() const { return piezas + fin; }
 };
 
+struct EstadoVisible;
+
 // =========================
 // Clase Participante (base)
 // Contiene nombre y la colección de piezas en mano.
@@ -68,6 +241,30 @@ class Participante {
 protected:
     string alias;                   // Nombre del participante
     vector<PiezaDomino> piezasMano; // Piezas que tiene en su mano
+    uint32_t mascaraMano = 0;       // Las mismas piezas como máscara de bits (doble seis)
+    int sumaPuntos = 0;             // Puntos de la mano, al día en cada cambio
+    // Índice por valor: cuántas piezas de la mano muestran cada valor (un
+    // doble cuenta una vez) y cuáles son. Comprobar si hay jugada para un
+    // extremo cuesta lo mismo con 7 piezas de doble seis que con 30 de doble quince.
+    int cantidadPorValor[VALOR_MAXIMO_SOPORTADO + 1] = {0};
+    vector<PiezaDomino> piezasPorValor[VALOR_MAXIMO_SOPORTADO + 1];
+
+    // Agrega (+1) o quita (-1) una pieza del índice por valor
+    void indexar(const PiezaDomino& p, int cambio) {
+        int a = p.obtenerIzquierdo(), b = p.obtenerDerecho();
+        for (int v : {a, b}) {
+            cantidadPorValor[v] += cambio;
+            vector<PiezaDomino>& lista = piezasPorValor[v];
+            if (cambio > 0) {
+                lista.push_back(p);
+            } else {
+                for (size_t i = 0; i < lista.size(); ++i)
+                    if (lista[i].esIgualA(p)) { lista[i] = lista.back(); lista.pop_back(); break; }
+            }
+            if (a == b) break;
+        }
+        sumaPuntos += cambio * p.totalPuntos();
+    }
 public:
     // Constructor: recibe el nombre del participante
     Participante(const string& nombre_) : alias(nombre_) {}
@@ -76,18 +273,40 @@ public:
     virtual ~Participante() = default;
 
     // Devuelve el nombre del participante
-    string obtenerNombre() const { return alias; }
+    const string& obtenerNombre() const { return alias; }
 
     // Agrega una pieza a la mano
-    void tomarPieza(const PiezaDomino& p) { piezasMano.push_back(p); }
+    void tomarPieza(const PiezaDomino& p) {
+        piezasMano.push_back(p);
+        mascaraMano |= p.mascara();
+        indexar(p, +1);
+    }
 
     // Quita y devuelve la pieza en el índice indicado
     PiezaDomino sacarPieza(int posicion) {
         PiezaDomino p = piezasMano[posicion];
         piezasMano.erase(piezasMano.begin() + posicion);
+        mascaraMano &= ~p.mascara();
+        indexar(p, -1);
         return p;
     }
 
+    // Mano como máscara de bits (bit i = pieza i)
+    uint32_t manoComoMascara() const { return mascaraMano; }
+
+    // Indica con dos consultas al índice si alguna pieza encaja en un
+    // extremo (extremos en -1: tablero vacío, cualquier pieza sirve)
+    bool tieneJugada(int extremoIzq, int extremoDer) const {
+        if (extremoIzq < 0) return !piezasMano.empty();
+        return (cantidadPorValor[extremoIzq] | cantidadPorValor[extremoDer]) != 0;
+    }
+
+    // Piezas de la mano que muestran el valor v
+    const vector<PiezaDomino>& piezasConValor(int v) const { return piezasPorValor[v]; }
+
+    // Suma de puntos de la mano
+    int puntosEnMano() const { return sumaPuntos; }
+
     // Indica cuántas piezas tiene en mano
     int cantidadPiezas() const { return (int)piezasMano.size(); }
 
@@ -102,13 +321,31 @@ public:
     }
 
     // Vacía completamente la mano (para reiniciar rondas)
-    void limpiarMano() { piezasMano.clear(); }
+    void limpiarMano() {
+        piezasMano.clear();
+        mascaraMano = 0;
+        sumaPuntos = 0;
+        for (int v = 0; v <= VALOR_MAXIMO_SOPORTADO; ++v) {
+            cantidadPorValor[v] = 0;
+            piezasPorValor[v].clear();
+        }
+    }
+
+    // Deja lugar para una mano de hasta 'piezas' piezas de un juego
+    // doble-'maximo', así robar durante la ronda no pide memoria
+    void reservarMano(int piezas, int maximo) {
+        piezasMano.reserve(piezas);
+        for (int v = 0; v <= maximo; ++v) piezasPorValor[v].reserve(maximo + 1);
+    }
 
-    // Método virtual puro: cada tipo de participante define su turno
-    virtual bool realizarJugada(deque<PiezaDomino>& tablero,
+    // Método virtual puro: cada tipo de participante define su turno.
+    // 'visible' es lo que la partida le muestra (entre otras cosas, la
+    // fuente de azar de la partida, para que una semilla la repita)
+    virtual bool realizarJugada(MesaDomino& tablero,
                                 vector<PiezaDomino>& pozo,
                                 int extremoIzq,
-                                int extremoDer) = 0;
+                                int extremoDer,
+                                const EstadoVisible& visible) = 0;
 };
 
 // =========================
@@ -121,10 +358,11 @@ public:
     ParticipanteHumano(const string& nombre_) : Participante(nombre_) {}
 
     // Lógica completa del turno para un jugador humano
-    bool realizarJugada(deque<PiezaDomino>& tablero,
+    bool realizarJugada(MesaDomino& tablero,
                         vector<PiezaDomino>& pozo,
                         int extremoIzq,
-                        int extremoDer) override
+                        int extremoDer,
+                        const EstadoVisible&) override
     {
         // --- Mostrar estado actual del juego ---
         cout << "\nTurno de " << alias << ":\n";
@@ -138,17 +376,10 @@ public:
         else cout << extremoIzq << " ... " << extremoDer << "\n";
         mostrarMano();
 
-        // --- Lambda: verifica si una pieza es jugable ---
-        auto esJugable = [&](const PiezaDomino& p) {
-            if (tablero.empty()) return true;
-            return p.obtenerIzquierdo() == extremoIzq || p.obtenerDerecho() == extremoIzq ||
-                   p.obtenerIzquierdo() == extremoDer || p.obtenerDerecho() == extremoDer;
-        };
-
         // --- Robar del pozo mientras no haya jugada válida ---
+        // (la mano como máscara: la comprobación son dos AND)
         while (true) {
-            bool hayJugable = false;
-            for (const auto& p : piezasMano) if (esJugable(p)) { hayJugable = true; break; }
+            bool hayJugable = tablero.empty() || tieneJugada(extremoIzq, extremoDer);
             if (hayJugable) break; // Ya puede jugar desde su mano
 
             if (!pozo.empty()) {
@@ -270,218 +501,3712 @@ public:
 }; // fin ParticipanteHumano
 
 // =========================
-// Clase PartidaDomino
-// Gestiona el flujo completo del juego: piezas, reparto, turnos, puntuación y rondas.
+// GeneradorRapido
+// splitmix64: estado de 64 bits, una suma y tres mezclas por número.
+// Cumple los requisitos de UniformRandomBitGenerator, así que también
+// sirve con shuffle() y las distribuciones de <random>.
 // =========================
-class PartidaDomino {
+class GeneradorRapido {
 private:
-    vector<PiezaDomino> fabricaPiezas;    // Conjunto completo de 28 piezas
-    vector<PiezaDomino> pozo;             // Piezas restantes para robar
-    deque<PiezaDomino> tablero;           // Piezas colocadas en la mesa
-    vector<Participante*> jugadores;      // Lista de participantes (polimorfismo)
-    map<string,int> puntuacionTotal;      // Puntos acumulados por nombre
-    int totalJugadores;                   // Número actual de jugadores
-    mt19937 generadorAleatorio;           // Motor de aleatorización
+    uint64_t estado;
+public:
+    using result_type = uint64_t;
+    explicit GeneradorRapido(uint64_t semilla = 0) : estado(semilla) {}
+
+    // Estado interno: GeneradorRapido(estadoActual()) sigue la misma secuencia
+    uint64_t estadoActual() const { return estado; }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        uint64_t z = (estado += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // Entero en [0, n) por multiplicación (sesgo menor que n / 2^32)
+    uint32_t menorQue(uint32_t n) {
+        return (uint32_t)(((uint64_t)(uint32_t)(*this)() * n) >> 32);
+    }
+};
 
+// =========================
+// Jugada y estado visible para los jugadores automáticos
+// =========================
+struct Jugada {
+    uint8_t pieza;  // Identificador de la pieza (0..27)
+    uint8_t lado;   // 0 = izquierda, 1 = derecha
+};
+
+// Jugada con la pieza completa: sirve en cualquier juego doble-N
+struct JugadaPieza {
+    PiezaDomino pieza;
+    uint8_t lado;   // 0 = izquierda, 1 = derecha
+};
+
+// Lo que un jugador puede ver en su turno (sin consola ni copias)
+struct EstadoVisible {
+    int extremoIzq = -1;                 // -1 si el tablero está vacío
+    int extremoDer = -1;
+    uint32_t mano = 0;                   // Piezas propias (máscara)
+    uint32_t enMesa = 0;                 // Piezas ya colocadas (máscara)
+    int piezasPozo = 0;
+    int jugador = 0;                     // Índice de quien juega
+    int totalJugadores = 0;
+    int piezasJugadores[MAX_JUGADORES] = {0};  // Piezas en mano de cada jugador
+    uint8_t valoresAusentes[MAX_JUGADORES] = {0};  // Valores (bit v) que cada jugador seguro no tiene
+    int valorMaximo = VALOR_MAXIMO;      // Juego doble-N de la mesa (las máscaras son de doble seis)
+    GeneradorRapido* azar = nullptr;     // Fuente de azar de la simulación
+
+    // Piezas en mesa que muestran el valor v
+    int vistosPorValor(int v) const { return contarBits(enMesa & tablaPiezas.mascaraValor[v]); }
+};
+
+// Genera las jugadas legales en tiempo constante por jugada: las piezas
+// de cada lado salen de un AND con la máscara del extremo. Con el
+// tablero vacío cualquier pieza vale (se anota como lado derecho).
+inline int generarJugadas(uint32_t mano, int extremoIzq, int extremoDer, Jugada* legales) {
+    uint32_t izquierda = extremoIzq < 0 ? 0 : mano & tablaPiezas.mascaraValor[extremoIzq];
+    uint32_t derecha = jugablesEn(mano, extremoDer);
+    int total = 0;
+    for (; izquierda; izquierda &= izquierda - 1) legales[total++] = {(uint8_t)bitMasBajo(izquierda), 0};
+    for (; derecha; derecha &= derecha - 1) legales[total++] = {(uint8_t)bitMasBajo(derecha), 1};
+    return total;
+}
+
+// Nuevo valor del extremo tras colocar la pieza en el lado indicado
+inline int extremoResultante(const Jugada& j, int extremoIzq, int extremoDer) {
+    int a = tablaPiezas.izquierdo[j.pieza], b = tablaPiezas.derecho[j.pieza];
+    if (extremoIzq < 0) return j.lado == 0 ? a : b;  // Primera pieza
+    int extremo = j.lado == 0 ? extremoIzq : extremoDer;
+    return a == extremo ? b : a;
+}
+
+inline int extremoResultante(const JugadaPieza& j, int extremoIzq, int extremoDer) {
+    int a = j.pieza.obtenerIzquierdo(), b = j.pieza.obtenerDerecho();
+    if (extremoIzq < 0) return j.lado == 0 ? a : b;
+    int extremo = j.lado == 0 ? extremoIzq : extremoDer;
+    return a == extremo ? b : a;
+}
+
+// =========================
+// ParticipanteAutomatico : derivado de Participante
+// Base de los jugadores sin consola: solo deben elegir una jugada entre
+// las legales. Sirve tanto para PartidaDomino (realizarJugada) como
+// para el simulador rápido (elegirJugada directamente). Mientras la
+// mano y los extremos sean de doble seis las jugadas salen de la máscara
+// de la mano; con valores mayores (doble 9, 12 o 15) salen del índice
+// por valor y se elige con elegirJugadaPieza.
+// =========================
+class ParticipanteAutomatico : public Participante {
 public:
-    // Constructor: inicializa el generador aleatorio con la hora actual
-    PartidaDomino() {
-        generadorAleatorio.seed((unsigned)time(nullptr));
+    ParticipanteAutomatico(const string& nombre_) : Participante(nombre_) {}
+
+    // Devuelve el índice (en 'legales') de la jugada elegida; total > 0
+    virtual int elegirJugada(const EstadoVisible& estado, const Jugada* legales, int total) = 0;
+
+    // Igual que elegirJugada para los juegos que no caben en la máscara.
+    // Por omisión se deshace de la pieza con más puntos
+    virtual int elegirJugadaPieza(const JugadaPieza* legales, int total, int, int, GeneradorRapido&) {
+        int mejor = 0;
+        for (int i = 1; i < total; ++i)
+            if (legales[i].pieza.totalPuntos() > legales[mejor].pieza.totalPuntos()) mejor = i;
+        return mejor;
     }
 
-    // Destructor: libera memoria de los jugadores
-    ~PartidaDomino() {
-        for (auto p : jugadores) delete p;
-        jugadores.clear();
+    // Jugadas legales a partir del índice por valor (extremos en -1:
+    // tablero vacío, cualquier pieza vale y se anota como lado derecho)
+    int generarJugadasPieza(int extremoIzq, int extremoDer, JugadaPieza* legales) const {
+        int total = 0;
+        if (extremoIzq < 0) {
+            for (const auto& p : piezasMano) legales[total++] = {p, 1};
+            return total;
+        }
+        for (const auto& p : piezasConValor(extremoIzq)) legales[total++] = {p, 0};
+        for (const auto& p : piezasConValor(extremoDer)) legales[total++] = {p, 1};
+        return total;
     }
 
-    // Genera las 28 piezas estándar (0-0 hasta 6-6)
-    void generarConjuntoCompleto() {
-        fabricaPiezas.clear();
-        for (int izq = 0; izq <= 6; ++izq)
-            for (int der = izq; der <= 6; ++der)
-                fabricaPiezas.emplace_back(izq, der);
+    // Turno dentro de PartidaDomino: mismas reglas que el jugador humano
+    // (roba hasta poder jugar o pasa si el pozo está vacío). 'visible'
+    // trae lo que la mesa sabe de los demás (asiento, manos, ausentes);
+    // aquí se completan los extremos, la mano, la mesa y el pozo
+    bool realizarJugada(MesaDomino& tablero,
+                        vector<PiezaDomino>& pozo,
+                        int extremoIzq,
+                        int extremoDer,
+                        const EstadoVisible& visible) override
+    {
+        Jugada legales[2 * TOTAL_PIEZAS];
+        int izq = tablero.empty() ? -1 : extremoIzq;
+        int der = tablero.empty() ? -1 : extremoDer;
+        while (true) {
+            // La máscara solo describe el doble seis: en los juegos grandes
+            // (aunque la mano y los extremos quepan, la mesa y las piezas
+            // de los rivales no) se usa el índice por valor
+            bool enMascara = visible.valorMaximo == VALOR_MAXIMO && max(izq, der) <= VALOR_MAXIMO &&
+                             contarBits(mascaraMano) == cantidadPiezas();
+            PiezaDomino buscada;
+            int lado = -1;
+            if (enMascara) {
+                int total = generarJugadas(mascaraMano, izq, der, legales);
+                if (total > 0) {
+                    EstadoVisible estado = visible;
+                    estado.extremoIzq = izq;
+                    estado.extremoDer = der;
+                    estado.mano = mascaraMano;
+                    estado.enMesa = 0;
+                    for (const auto& p : tablero) estado.enMesa |= p.mascara();
+                    estado.piezasPozo = (int)pozo.size();
+                    estado.piezasJugadores[estado.jugador] = cantidadPiezas();
+                    Jugada j = legales[elegirJugada(estado, legales, total)];
+                    buscada = PiezaDomino::desdeIdentificador(j.pieza);
+                    lado = j.lado;
+                }
+            } else {
+                JugadaPieza legalesPieza[2 * MAX_PIEZAS_CONJUNTO];
+                int total = generarJugadasPieza(izq, der, legalesPieza);
+                if (total > 0) {
+                    const JugadaPieza& j = legalesPieza[elegirJugadaPieza(legalesPieza, total, izq, der, *visible.azar)];
+                    buscada = j.pieza;
+                    lado = j.lado;
+                }
+            }
+            if (lado >= 0) {
+                // Se busca por ambos valores: el identificador depende del juego
+                int idx = 0;
+                while (!piezasMano[idx].esIgualA(buscada)) ++idx;
+                PiezaDomino elegida = sacarPieza(idx);
+                if (tablero.empty()) {
+                    tablero.push_back(elegida);
+                } else if (lado == 0) {
+                    if (elegida.obtenerDerecho() != extremoIzq) elegida.voltear();
+                    tablero.push_front(elegida);
+                } else {
+                    if (elegida.obtenerIzquierdo() != extremoDer) elegida.voltear();
+                    tablero.push_back(elegida);
+                }
+                cout << alias << " coloca " << elegida.comoTexto() << "\n";
+                return true;
+            }
+            if (pozo.empty()) {
+                cout << alias << " no puede jugar y el pozo está vacío. Hace PASS.\n";
+                return false;
+            }
+            tomarPieza(pozo.back());
+            pozo.pop_back();
+        }
     }
+};
 
-    // Baraja las piezas y prepara el pozo
-    void mezclarYPreparar() {
-        generarConjuntoCompleto();
-        shuffle(fabricaPiezas.begin(), fabricaPiezas.end(), generadorAleatorio);
-        pozo = fabricaPiezas; // Copia completa al pozo
+// =========================
+// ParticipanteAleatorio: cualquier jugada legal, con igual probabilidad
+// =========================
+class ParticipanteAleatorio : public ParticipanteAutomatico {
+public:
+    ParticipanteAleatorio(const string& nombre_) : ParticipanteAutomatico(nombre_) {}
+
+    int elegirJugada(const EstadoVisible& estado, const Jugada*, int total) override {
+        return (int)estado.azar->menorQue((uint32_t)total);
     }
 
-    // Solicita número y nombres de jugadores (2-4)
-    void configurarParticipantes() {
-        for (auto p : jugadores) delete p;
-        jugadores.clear();
-        puntuacionTotal.clear();
+    int elegirJugadaPieza(const JugadaPieza*, int total, int, int, GeneradorRapido& azar) override {
+        return (int)azar.menorQue((uint32_t)total);
+    }
+};
 
-        cout << "Ingrese número de jugadores (2-4): ";
-        while (true) {
-            cin >> totalJugadores;
-            if (cin.fail() || totalJugadores < 2 || totalJugadores > 4) {
-                cout << "Número inválido. Ingrese entre 2 y 4: ";
-                cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            } else break;
+// =========================
+// ParticipanteCodicioso: se deshace primero de la pieza con más puntos
+// =========================
+class ParticipanteCodicioso : public ParticipanteAutomatico {
+public:
+    ParticipanteCodicioso(const string& nombre_) : ParticipanteAutomatico(nombre_) {}
+
+    int elegirJugada(const EstadoVisible&, const Jugada* legales, int total) override {
+        // Clave = puntos·64 + (63 − i): el máximo es la primera de más puntos
+        int mejorClave = 0;
+        for (int i = 0; i < total; ++i)
+            mejorClave = max(mejorClave, tablaPiezas.puntos[legales[i].pieza] * 64 + (63 - i));
+        return 63 - (mejorClave & 63);
+    }
+};
+
+// =========================
+// ParticipanteHeuristico: combina varios criterios simples
+//  - puntos de la pieza (conviene soltar las pesadas)
+//  - dobles (son las más difíciles de colocar después)
+//  - piezas propias que seguirían pudiendo jugar en el nuevo extremo
+//  - valores muy vistos en la mesa (los rivales probablemente no los tienen)
+// =========================
+class ParticipanteHeuristico : public ParticipanteAutomatico {
+public:
+    ParticipanteHeuristico(const string& nombre_) : ParticipanteAutomatico(nombre_) {}
+
+    int elegirJugada(const EstadoVisible& estado, const Jugada* legales, int total) override {
+        int mejor = 0, mejorPuntaje = INT_MIN;
+        for (int i = 0; i < total; ++i) {
+            const Jugada& j = legales[i];
+            int nuevo = extremoResultante(j, estado.extremoIzq, estado.extremoDer);
+            // Piezas propias (sin contar la jugada) que encajarían en el nuevo extremo
+            int seguidoras = contarBits(estado.mano & ~(1u << j.pieza) & tablaPiezas.mascaraValor[nuevo]);
+            int doble = tablaPiezas.izquierdo[j.pieza] == tablaPiezas.derecho[j.pieza];
+            int puntaje = 2 * tablaPiezas.puntos[j.pieza] + 6 * doble + 3 * seguidoras +
+                          2 * estado.vistosPorValor(nuevo);
+            if (puntaje > mejorPuntaje) { mejorPuntaje = puntaje; mejor = i; }
         }
+        return mejor;
+    }
 
-        for (int i = 0; i < totalJugadores; ++i) {
-            cout << "Nombre del jugador " << (i+1) << ": ";
-            string nombre;
-            cin >> ws; getline(cin, nombre);
-            if (nombre.empty()) nombre = "Jugador" + to_string(i+1);
-            Participante* p = new ParticipanteHumano(nombre);
-            jugadores.push_back(p);
-            puntuacionTotal[nombre] = 0;
+    // Los mismos criterios con el índice por valor, salvo los valores
+    // vistos en mesa (la mesa no se recorre en cada turno)
+    int elegirJugadaPieza(const JugadaPieza* legales, int total, int extremoIzq, int extremoDer,
+                          GeneradorRapido&) override {
+        int mejor = 0, mejorPuntaje = INT_MIN;
+        for (int i = 0; i < total; ++i) {
+            const PiezaDomino& p = legales[i].pieza;
+            int nuevo = extremoResultante(legales[i], extremoIzq, extremoDer);
+            int propia = p.obtenerIzquierdo() == nuevo || p.obtenerDerecho() == nuevo;
+            int seguidoras = cantidadPorValor[nuevo] - propia;
+            int doble = p.obtenerIzquierdo() == p.obtenerDerecho();
+            int puntaje = 2 * p.totalPuntos() + 6 * doble + 3 * seguidoras;
+            if (puntaje > mejorPuntaje) { mejorPuntaje = puntaje; mejor = i; }
         }
+        return mejor;
     }
+};
 
-    // Reparte 7 piezas a cada jugador; el resto queda en el pozo
-    void distribuirPiezas() {
-        for (auto p : jugadores) p->limpiarMano();
-        tablero.clear();
+// =========================
+// Solucionador exacto del final (2 jugadores, pozo vacío)
+// Sin pozo ya no hay azar y, con dos jugadores, la mano del rival es
+// todo lo que no está en la propia ni en la mesa: el resto de la ronda
+// es un juego de información perfecta y suma cero. Valor para quien
+// juega: +puntos del rival si gana la ronda, −puntos propios si la
+// pierde (en un bloqueo gana la menor suma).
+// Búsqueda negamax con poda alfa-beta; las jugadas se ordenan por la
+// mejor de la tabla, luego las que dejan al rival sin jugada y luego
+// las de más puntos. La tabla de transposiciones usa claves Zobrist
+// (una clave por pieza y dueño, por valor de cada extremo, por turno y
+// por pase pendiente) actualizadas con XOR en cada jugada, y ocupa un
+// presupuesto fijo de memoria: cubetas de dos entradas, una que conserva
+// la posición con más piezas (subárbol más caro) y otra que siempre se
+// reemplaza.
+// =========================
+struct ClavesZobrist {
+    uint64_t pieza[2][TOTAL_PIEZAS];         // Pieza en la mano del jugador 0 o 1
+    uint64_t extremoIzq[VALOR_MAXIMO + 2];   // Índice valor + 1 (0: tablero vacío)
+    uint64_t extremoDer[VALOR_MAXIMO + 2];
+    uint64_t turno;                          // Le toca al jugador 1
+    uint64_t pase;                           // El jugador anterior pasó
+    uint64_t desempate;                      // El jugador 0 gana los empates
+    ClavesZobrist() {
+        GeneradorRapido g(0x2545F4914F6CDD1DULL);
+        for (auto& fila : pieza)
+            for (auto& k : fila) k = g();
+        for (auto& k : extremoIzq) k = g();
+        for (auto& k : extremoDer) k = g();
+        turno = g();
+        pase = g();
+        desempate = g();
+    }
+};
+static const ClavesZobrist clavesZobrist;
 
-        for (int r = 0; r < 7; ++r) {
-            for (auto p : jugadores) {
-                if (pozo.empty()) break;
-                PiezaDomino pieza = pozo.back(); pozo.pop_back();
-                p->tomarPieza(pieza);
-            }
-        }
+class SolucionadorFinal {
+public:
+    struct Estadisticas {
+        long long nodos = 0;      // Posiciones visitadas
+        long long consultas = 0;  // Búsquedas en la tabla
+        long long aciertos = 0;   // Consultas que encontraron la posición
+        long long cortes = 0;     // Podas beta
+    };
+
+private:
+    struct Entrada {
+        uint64_t clave = 0;
+        int16_t valor = 0;
+        uint8_t tipo = 0;         // EXACTO, COTA_INFERIOR o COTA_SUPERIOR
+        uint8_t jugada = SIN_JUGADA;  // pieza | lado << 5
+        uint8_t piezas = 0;       // Piezas en ambas manos (0: entrada libre)
+    };
+    static const uint8_t EXACTO = 0, COTA_INFERIOR = 1, COTA_SUPERIOR = 2;
+    static const uint8_t SIN_JUGADA = 0xFF;
+    static const int INFINITO = 1000;
+
+    vector<Entrada> tabla;        // Potencia de dos; la cubeta i ocupa [2i, 2i+1]
+    uint64_t mascaraCubetas = 0;
+    uint32_t manos[2];
+    bool ganaEmpateJugador0 = false;
+    Jugada mejorRaiz;
+    Estadisticas estadisticas;
+
+    // Valor de un bloqueo para el jugador que debía jugar
+    int valorBloqueo(int turno) const {
+        int propios = puntosDe(manos[turno]), ajenos = puntosDe(manos[turno ^ 1]);
+        bool gana = propios < ajenos || (propios == ajenos && ganaEmpateJugador0 == (turno == 0));
+        return gana ? ajenos : -propios;
     }
 
-    // Ejecuta una ronda completa hasta que alguien gane o se bloquee
-    string ejecutarRonda() {
-        mezclarYPreparar();
-        distribuirPiezas();
+    int buscar(int turno, int izq, int der, bool pase, uint64_t clave, int alfa, int beta, bool raiz) {
+        ++estadisticas.nodos;
 
-        int turnoActual = 0;
-        int pasesConsecutivos = 0;
-        tablero.clear();
+        // Consulta de la tabla
+        Entrada* cubeta = &tabla[(clave & mascaraCubetas) * 2];
+        uint8_t jugadaTabla = SIN_JUGADA;
+        ++estadisticas.consultas;
+        for (int k = 0; k < 2; ++k) {
+            const Entrada& e = cubeta[k];
+            if (e.piezas == 0 || e.clave != clave) continue;
+            ++estadisticas.aciertos;
+            jugadaTabla = e.jugada;
+            if (!raiz) {
+                if (e.tipo == EXACTO) return e.valor;
+                if (e.tipo == COTA_INFERIOR) alfa = max(alfa, (int)e.valor);
+                else beta = min(beta, (int)e.valor);
+                if (alfa >= beta) return e.valor;
+            }
+            break;
+        }
+        const int alfaOriginal = alfa;  // Ventana ya ajustada con la tabla
 
-        while (true) {
-            Participante* jugadorActual = jugadores[turnoActual];
+        uint32_t mano = manos[turno], rival = manos[turno ^ 1];
+        Jugada legales[2 * TOTAL_PIEZAS];
+        int total = generarJugadas(mano, izq, der, legales);
+        if (total == 0) {
+            if (pase) return valorBloqueo(turno);  // Los dos pasaron seguidos
+            return -buscar(turno ^ 1, izq, der, true, clave ^ clavesZobrist.turno ^ clavesZobrist.pase,
+                           -beta, -alfa, false);
+        }
 
-            // Obtener valores de los extremos del tablero
-            int valIzq = -1, valDer = -1;
-            if (!tablero.empty()) {
-                valIzq = tablero.front().obtenerIzquierdo();
-                valDer = tablero.back().obtenerDerecho();
+        // Ordenar: jugada de la tabla, las que dejan al rival sin jugada y
+        // las de más puntos (dobles primero en empate). Con ambos extremos
+        // iguales, la misma pieza a cada lado da la misma posición.
+        int orden[2 * TOTAL_PIEZAS], prioridad[2 * TOTAL_PIEZAS], usadas = 0;
+        for (int i = 0; i < total; ++i) {
+            const Jugada& j = legales[i];
+            if (izq == der && izq >= 0 && j.lado == 0) continue;
+            int a = tablaPiezas.izquierdo[j.pieza], b = tablaPiezas.derecho[j.pieza];
+            int nuevo = extremoResultante(j, izq, der);
+            int ni = izq < 0 ? a : j.lado == 0 ? nuevo : izq;
+            int nd = izq < 0 ? b : j.lado == 0 ? der : nuevo;
+            int p = 4 * tablaPiezas.puntos[j.pieza] + (a == b);
+            if ((jugablesEn(rival, ni) | jugablesEn(rival, nd)) == 0) p += 256;
+            if ((j.pieza | j.lado << 5) == jugadaTabla) p += 1024;
+            int k = usadas++;
+            for (; k > 0 && prioridad[k - 1] < p; --k) {
+                orden[k] = orden[k - 1];
+                prioridad[k] = prioridad[k - 1];
             }
+            orden[k] = i;
+            prioridad[k] = p;
+        }
 
-            bool jugo = jugadorActual->realizarJugada(tablero, pozo, valIzq, valDer);
-            if (jugo) {
-                pasesConsecutivos = 0;
-                if (jugadorActual->cantidadPiezas() == 0) {
-                    cout << "\n*** " << jugadorActual->obtenerNombre()
-                         << " se quedó sin piezas y gana la ronda! ***\n";
-                    return jugadorActual->obtenerNombre();
-                }
+        int mejor = -INFINITO;
+        uint8_t mejorJugada = SIN_JUGADA;
+        uint64_t claveBase = clave ^ clavesZobrist.turno ^ (pase ? clavesZobrist.pase : 0) ^
+                             clavesZobrist.extremoIzq[izq + 1] ^ clavesZobrist.extremoDer[der + 1];
+        for (int n = 0; n < usadas; ++n) {
+            const Jugada& j = legales[orden[n]];
+            uint32_t bit = 1u << j.pieza;
+            int valor;
+            if (mano == bit) {
+                valor = puntosDe(rival);  // Última pieza: gana la ronda
             } else {
-                pasesConsecutivos++;
-                cout << jugadorActual->obtenerNombre() << " pasó.\n";
+                int nuevo = extremoResultante(j, izq, der);
+                int ni = izq < 0 ? tablaPiezas.izquierdo[j.pieza] : j.lado == 0 ? nuevo : izq;
+                int nd = izq < 0 ? tablaPiezas.derecho[j.pieza] : j.lado == 0 ? der : nuevo;
+                uint64_t hijo = claveBase ^ clavesZobrist.pieza[turno][j.pieza] ^
+                                clavesZobrist.extremoIzq[ni + 1] ^ clavesZobrist.extremoDer[nd + 1];
+                manos[turno] = mano & ~bit;
+                valor = -buscar(turno ^ 1, ni, nd, false, hijo, -beta, -alfa, false);
+                manos[turno] = mano;
             }
-
-            // Detectar bloqueo: todos los jugadores pasaron consecutivamente
-            if (pasesConsecutivos >= totalJugadores) {
-                cout << "\n--- Estado de bloqueo: ninguno puede jugar ---\n";
-                return ""; // Cadena vacía indica bloqueo
+            if (valor > mejor) {
+                mejor = valor;
+                mejorJugada = (uint8_t)(j.pieza | j.lado << 5);
+                if (raiz) mejorRaiz = j;
+            }
+            if (mejor > alfa) alfa = mejor;
+            if (alfa >= beta) {
+                ++estadisticas.cortes;
+                break;
             }
-
-            turnoActual = (turnoActual + 1) % totalJugadores;
         }
+
+        // Guardar: la entrada 0 conserva la posición con más piezas
+        Entrada nueva;
+        nueva.clave = clave;
+        nueva.valor = (int16_t)mejor;
+        nueva.tipo = mejor <= alfaOriginal ? COTA_SUPERIOR : mejor >= beta ? COTA_INFERIOR : EXACTO;
+        nueva.jugada = mejorJugada;
+        nueva.piezas = (uint8_t)contarBits(mano | rival);
+        if (cubeta[0].clave == clave || nueva.piezas >= cubeta[0].piezas) cubeta[0] = nueva;
+        else cubeta[1] = nueva;
+        return mejor;
     }
 
-    // Calcula puntos de la ronda y actualiza acumulados
-    string procesarPuntuacion(const string& nombreGanador) {
-        map<string,int> sumasPips;
-        for (auto p : jugadores) {
-            int suma = 0;
-            for (int i = 0; i < p->cantidadPiezas(); ++i)
-                suma += p->verPieza(i).totalPuntos();
-            sumasPips[p->obtenerNombre()] = suma;
-        }
-
-        if (!nombreGanador.empty()) {
-            // Ganador directo: suma de pips de los demás
-            int puntos = 0;
-            for (auto& kv : sumasPips) if (kv.first != nombreGanador) puntos += kv.second;
-            puntuacionTotal[nombreGanador] += puntos;
-            cout << nombreGanador << " obtiene " << puntos << " puntos de esta ronda.\n";
-            return nombreGanador;
+public:
+    // Constructor: la tabla ocupa a lo sumo 'bytesTabla' (mínimo una cubeta)
+    explicit SolucionadorFinal(size_t bytesTabla = 16u << 20) {
+        size_t cubetas = 1;
+        while (cubetas * 2 * 2 * sizeof(Entrada) <= bytesTabla) cubetas *= 2;
+        tabla.assign(cubetas * 2, Entrada());
+        mascaraCubetas = cubetas - 1;
+    }
+
+    // Valor exacto de la posición para quien juega y, si puede jugar, su
+    // mejor jugada. 'ganaEmpate': si quien juega gana un bloqueo empatado.
+    // Los extremos en -1 indican tablero vacío.
+    int resolver(uint32_t manoTurno, uint32_t manoRival, int izq, int der, bool ganaEmpate, Jugada* mejor) {
+        manos[0] = manoTurno;
+        manos[1] = manoRival;
+        ganaEmpateJugador0 = ganaEmpate;
+        uint64_t clave = clavesZobrist.extremoIzq[izq + 1] ^ clavesZobrist.extremoDer[der + 1] ^
+                         (ganaEmpate ? clavesZobrist.desempate : 0);
+        for (uint32_t m = manoTurno; m; m &= m - 1) clave ^= clavesZobrist.pieza[0][bitMasBajo(m)];
+        for (uint32_t m = manoRival; m; m &= m - 1) clave ^= clavesZobrist.pieza[1][bitMasBajo(m)];
+        mejorRaiz = {SIN_JUGADA, 0};
+        int valor = buscar(0, izq, der, false, clave, -INFINITO, INFINITO, true);
+        if (mejor) *mejor = mejorRaiz;
+        return valor;
+    }
+
+    // Vacía la tabla (las estadísticas se conservan)
+    void limpiarTabla() { fill(tabla.begin(), tabla.end(), Entrada()); }
+
+    size_t bytesTabla() const { return tabla.size() * sizeof(Entrada); }
+    const Estadisticas& obtenerEstadisticas() const { return estadisticas; }
+    void reiniciarEstadisticas() { estadisticas = Estadisticas(); }
+};
+
+// =========================
+// ParticipanteFinal: juega como el heurístico mientras haya pozo y,
+// cuando la posición se puede resolver (pozo vacío, dos jugadores),
+// elige la jugada exacta del solucionador. No conoce los nombres de los
+// rivales, así que supone que pierde los bloqueos empatados.
+// =========================
+class ParticipanteFinal : public ParticipanteHeuristico {
+private:
+    SolucionadorFinal solucionador;
+public:
+    ParticipanteFinal(const string& nombre_, size_t bytesTabla = 16u << 20)
+        : ParticipanteHeuristico(nombre_), solucionador(bytesTabla) {}
+
+    int elegirJugada(const EstadoVisible& estado, const Jugada* legales, int total) override {
+        if (estado.piezasPozo > 0 || estado.totalJugadores != 2)
+            return ParticipanteHeuristico::elegirJugada(estado, legales, total);
+        uint32_t rival = TODAS_LAS_PIEZAS & ~estado.mano & ~estado.enMesa;
+        Jugada mejor;
+        solucionador.resolver(estado.mano, rival, estado.extremoIzq, estado.extremoDer, false, &mejor);
+        // Con ambos extremos iguales el solucionador solo prueba el lado derecho
+        bool ladoIndiferente = estado.extremoIzq == estado.extremoDer;
+        for (int i = 0; i < total; ++i)
+            if (legales[i].pieza == mejor.pieza && (ladoIndiferente || legales[i].lado == mejor.lado))
+                return i;
+        return 0;
+    }
+
+    const SolucionadorFinal& obtenerSolucionador() const { return solucionador; }
+};
+
+// =========================
+// ParticipanteISMCTS: búsqueda Monte Carlo sobre conjuntos de información
+// Antes del final las manos rivales están ocultas, así que cada
+// iteración sortea una "determinización": reparte las piezas no vistas
+// entre los rivales (respetando cuántas tiene cada uno y los valores que
+// se sabe que no tienen) y el pozo. Sobre esa muestra baja por un árbol
+// común cuyas aristas son jugadas (pieza y lado, o pase): en cada nodo
+// solo compiten los hijos legales en la muestra, con UCB1 usando cuántas
+// veces estuvo disponible cada hijo. Luego completa la ronda con jugadas
+// al azar y suma una victoria a los nodos del jugador que ganó.
+// Paralelismo de raíz: cada hilo construye su propio árbol con su propio
+// azar y al final se suman las visitas de las jugadas de la raíz.
+// Sin datos de los rivales (menos de dos jugadores en el estado) o en
+// los juegos grandes juega como el heurístico.
+// =========================
+
+// Estado completo de una ronda (determinizada) para las simulaciones
+struct EstadoSimulado {
+    static const uint8_t PASE = 63;  // Código de pase (las jugadas son pieza | lado << 5)
+
+    uint32_t manos[MAX_JUGADORES];
+    uint8_t pozo[TOTAL_PIEZAS];
+    int tamPozo = 0;
+    int extremoIzq = -1, extremoDer = -1;
+    int turno = 0;
+    int pasesConsecutivos = 0;
+    int totalJugadores = 2;
+    int ganador = -1;  // >= 0 cuando la ronda terminó
+
+    // Baraja y reparte como SimuladorDomino: 7 piezas por jugador desde el
+    // final del pozo; empieza el jugador 0
+    void repartir(int jugadores, GeneradorRapido& azar) {
+        for (int i = 0; i < TOTAL_PIEZAS; ++i) pozo[i] = (uint8_t)i;
+        for (int i = TOTAL_PIEZAS - 1; i > 0; --i) swap(pozo[i], pozo[azar.menorQue((uint32_t)i + 1)]);
+        tamPozo = TOTAL_PIEZAS;
+        totalJugadores = jugadores;
+        for (int j = 0; j < jugadores; ++j) manos[j] = 0;
+        for (int r = 0; r < PIEZAS_POR_MANO; ++r)
+            for (int j = 0; j < jugadores; ++j) manos[j] |= 1u << pozo[--tamPozo];
+        extremoIzq = extremoDer = -1;
+        turno = 0;
+        pasesConsecutivos = 0;
+        ganador = -1;
+    }
+
+    // Roba hasta poder jugar y deja en 'codigos' las jugadas legales del
+    // jugador de turno (solo el pase si no puede); devuelve cuántas son
+    int prepararTurno(uint8_t* codigos) {
+        uint32_t& mano = manos[turno];
+        while (!(jugablesEn(mano, extremoIzq) | jugablesEn(mano, extremoDer)) && tamPozo > 0)
+            mano |= 1u << pozo[--tamPozo];
+        Jugada legales[2 * TOTAL_PIEZAS];
+        int total = generarJugadas(mano, extremoIzq, extremoDer, legales), n = 0;
+        bool mismoValor = extremoIzq >= 0 && extremoIzq == extremoDer;
+        for (int i = 0; i < total; ++i)
+            if (!(mismoValor && legales[i].lado == 0)) codigos[n++] = (uint8_t)(legales[i].pieza | legales[i].lado << 5);
+        if (n == 0) codigos[n++] = PASE;
+        return n;
+    }
+
+    // Aplica una jugada (o pase) del jugador de turno y pasa el turno
+    void aplicar(uint8_t codigo) {
+        if (codigo == PASE) {
+            if (++pasesConsecutivos >= totalJugadores) {
+                // Bloqueo: gana la menor suma (empates: el índice menor)
+                ganador = 0;
+                for (int p = 1; p < totalJugadores; ++p)
+                    if (puntosDe(manos[p]) < puntosDe(manos[ganador])) ganador = p;
+                return;
+            }
         } else {
-            // Bloqueo: gana quien tenga menor suma de pips
-            string ganadorBloqueo = "";
-            int menorSuma = INT_MAX;
-            for (auto& kv : sumasPips) {
-                if (kv.second < menorSuma) { menorSuma = kv.second; ganadorBloqueo = kv.first; }
+            Jugada j = {(uint8_t)(codigo & 31), (uint8_t)(codigo >> 5)};
+            int nuevo = extremoResultante(j, extremoIzq, extremoDer);
+            if (extremoIzq < 0) {
+                extremoIzq = tablaPiezas.izquierdo[j.pieza];
+                extremoDer = tablaPiezas.derecho[j.pieza];
+            } else if (j.lado == 0) {
+                extremoIzq = nuevo;
+            } else {
+                extremoDer = nuevo;
+            }
+            manos[turno] &= ~(1u << j.pieza);
+            pasesConsecutivos = 0;
+            if (manos[turno] == 0) {
+                ganador = turno;
+                return;
             }
-            int puntos = 0;
-            for (auto& kv : sumasPips) if (kv.first != ganadorBloqueo) puntos += kv.second;
-            puntuacionTotal[ganadorBloqueo] += puntos;
-            cout << "Bloqueo: gana " << ganadorBloqueo << " con menor total (" << menorSuma << ").\n";
-            cout << ganadorBloqueo << " obtiene " << puntos << " puntos de esta ronda.\n";
-            return ganadorBloqueo;
         }
+        turno = turno + 1 == totalJugadores ? 0 : turno + 1;
     }
+};
 
-    // Muestra los puntajes acumulados actuales
-    void mostrarPuntajes() const {
-        cout << "\n=== PUNTAJES ACUMULADOS ===\n";
-        for (const auto& kv : puntuacionTotal) {
-            cout << " " << kv.first << ": " << kv.second << "\n";
+// Una pieza al azar de una máscara no vacía
+inline int piezaAlAzar(uint32_t mascara, GeneradorRapido& azar) {
+    for (uint32_t k = azar.menorQue((uint32_t)contarBits(mascara)); k > 0; --k) mascara &= mascara - 1;
+    return bitMasBajo(mascara);
+}
+
+class ParticipanteISMCTS : public ParticipanteHeuristico {
+public:
+    struct Estadisticas {
+        long long decisiones = 0;
+        long long iteraciones = 0;   // Suma de todos los hilos
+        double segundos = 0;         // Tiempo de pared pensando
+        unsigned hilos = 1;
+    };
+
+private:
+    struct Nodo {
+        uint8_t codigo = 0;          // Jugada que lleva a este nodo
+        uint8_t jugador = 0;         // Quién la hizo
+        int visitas = 0;
+        int disponible = 0;          // Veces que fue legal al pasar por su padre
+        float victorias = 0;
+        int primerHijo = -1;
+        int hermano = -1;
+    };
+
+    unsigned hilos;
+    double milisegundos;             // Presupuesto de tiempo por jugada
+    long long iteracionesPorHilo;    // 0: sin límite (solo el tiempo)
+    double exploracion = 0.7;
+    Estadisticas estadisticas;
+
+    // Reparte las piezas no vistas: cada rival recibe tantas como tiene,
+    // evitando los valores que se sabe que no tiene; el resto va al pozo
+    static void determinizar(const EstadoVisible& e, GeneradorRapido& azar, EstadoSimulado& s) {
+        uint32_t noVistas = TODAS_LAS_PIEZAS & ~e.mano & ~e.enMesa;
+        int orden[MAX_JUGADORES], rivales = 0;
+        uint32_t permitidas[MAX_JUGADORES];
+        for (int j = 0; j < e.totalJugadores; ++j) {
+            if (j == e.jugador) continue;
+            uint32_t prohibidas = 0;
+            for (int v = 0; v <= VALOR_MAXIMO; ++v)
+                if (e.valoresAusentes[j] >> v & 1) prohibidas |= tablaPiezas.mascaraValor[v];
+            permitidas[j] = noVistas & ~prohibidas;
+            // Primero los rivales con menos opciones
+            int k = rivales++;
+            for (; k > 0 && contarBits(permitidas[orden[k - 1]]) > contarBits(permitidas[j]); --k)
+                orden[k] = orden[k - 1];
+            orden[k] = j;
         }
-        cout << "==========================\n";
+        for (int intento = 0; ; ++intento) {
+            bool restringido = intento < 8;  // Si no sale, se ignoran las ausencias
+            uint32_t libres = noVistas;
+            bool ok = true;
+            for (int r = 0; r < rivales && ok; ++r) {
+                int j = orden[r];
+                uint32_t mano = 0;
+                for (int n = 0; n < e.piezasJugadores[j]; ++n) {
+                    uint32_t opciones = libres & (restringido ? permitidas[j] : TODAS_LAS_PIEZAS);
+                    if (!opciones) { ok = false; break; }
+                    uint32_t bit = 1u << piezaAlAzar(opciones, azar);
+                    mano |= bit;
+                    libres &= ~bit;
+                }
+                s.manos[j] = mano;
+            }
+            if (!ok) continue;
+            s.tamPozo = 0;
+            for (; libres; libres &= libres - 1) s.pozo[s.tamPozo++] = (uint8_t)bitMasBajo(libres);
+            for (int i = s.tamPozo - 1; i > 0; --i) swap(s.pozo[i], s.pozo[azar.menorQue((uint32_t)i + 1)]);
+            break;
+        }
+        s.manos[e.jugador] = e.mano;
+        s.extremoIzq = e.extremoIzq;
+        s.extremoDer = e.extremoDer;
+        s.turno = e.jugador;
+        s.pasesConsecutivos = 0;
+        s.totalJugadores = e.totalJugadores;
+        s.ganador = -1;
     }
 
-    // Flujo principal del juego
-    void iniciar() {
-        cout << "===== BIENVENIDO A DOMINÓ (CONSOLE) =====\n";
-        configurarParticipantes();
-        bool salir = false;
+    // Un árbol completo; devuelve las visitas de cada jugada de la raíz
+    void buscar(const EstadoVisible& e, uint64_t semilla, chrono::steady_clock::time_point limite,
+                long long& iteraciones, int visitasRaiz[64]) const {
+        GeneradorRapido azar(semilla);
+        vector<Nodo> arbol(1);
+        arbol.reserve(iteracionesPorHilo > 0 ? (size_t)iteracionesPorHilo + 1 : 1 << 16);
+        int camino[4 * TOTAL_PIEZAS + 8];
+        uint8_t codigos[2 * TOTAL_PIEZAS];
+        EstadoSimulado s;
 
-        while (!salir) {
-            cout << "\n--> Nueva ronda: barajando y repartiendo...\n";
-            string ganadorRonda = ejecutarRonda();
-            string ganadorFinal = procesarPuntuacion(ganadorRonda);
-            cout << "\nResumen de la ronda: ganador -> ";
-            if (!ganadorFinal.empty()) cout << ganadorFinal << "\n";
-            else cout << "Ninguno (bloqueo)\n";
-            mostrarPuntajes();
+        for (iteraciones = 0; ; ++iteraciones) {
+            if (iteracionesPorHilo > 0 ? iteraciones >= iteracionesPorHilo
+                                       : (iteraciones & 31) == 0 && chrono::steady_clock::now() >= limite)
+                break;
+            determinizar(e, azar, s);
 
-            // Opciones tras la ronda
-            cout << "\nOpciones:\n"
-                 << " 1 - Jugar otra ronda (mantener puntajes)\n"
-                 << " 2 - Reiniciar puntajes y empezar desde cero\n"
-                 << " 3 - Reiniciar jugadores y empezar con nueva configuración\n"
-                 << " 4 - Salir\n"
-                 << "Elija una opción: ";
-            int opcion;
-            cin >> opcion;
-            if (cin.fail()) { cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n'); continue; }
+            // Selección y expansión
+            int nodo = 0, largo = 0;
+            while (s.ganador < 0) {
+                int n = s.prepararTurno(codigos);
+                uint64_t legales = 0;
+                for (int i = 0; i < n; ++i) legales |= 1ULL << codigos[i];
+                uint64_t probados = 0;
+                int elegido = -1;
+                double mejor = -1;
+                for (int h = arbol[nodo].primerHijo; h >= 0; h = arbol[h].hermano) {
+                    Nodo& hijo = arbol[h];
+                    if (!(legales >> hijo.codigo & 1)) continue;
+                    probados |= 1ULL << hijo.codigo;
+                    hijo.disponible++;
+                    double ucb = hijo.victorias / hijo.visitas +
+                                 exploracion * sqrt(log((double)hijo.disponible) / hijo.visitas);
+                    if (ucb > mejor) { mejor = ucb; elegido = h; }
+                }
+                uint64_t sinProbar = legales & ~probados;
+                if (sinProbar) {
+                    // Expandir una jugada nueva al azar
+                    int cuantos = contarBits(sinProbar);
+                    for (uint32_t k = azar.menorQue((uint32_t)cuantos); k > 0; --k) sinProbar &= sinProbar - 1;
+                    Nodo hijo;
+                    hijo.codigo = (uint8_t)bitMasBajo(sinProbar);
+                    hijo.jugador = (uint8_t)s.turno;
+                    hijo.disponible = 1;
+                    hijo.hermano = arbol[nodo].primerHijo;
+                    arbol.push_back(hijo);
+                    int nuevo = (int)arbol.size() - 1;
+                    arbol[nodo].primerHijo = nuevo;
+                    s.aplicar(hijo.codigo);
+                    camino[largo++] = nodo = nuevo;
+                    break;
+                }
+                s.aplicar(arbol[elegido].codigo);
+                camino[largo++] = nodo = elegido;
+            }
 
-            if (opcion == 1) {
-                continue;
-            } else if (opcion == 2) {
-                for (auto& kv : puntuacionTotal) kv.second = 0;
-                cout << "Puntajes reiniciados.\n";
-            } else if (opcion == 3) {
-                configurarParticipantes();
-            } else if (opcion == 4) {
-                salir = true;
-            } else {
-                cout << "Opción desconocida, continuando.\n";
+            // Simulación al azar hasta el final de la ronda
+            while (s.ganador < 0) {
+                int n = s.prepararTurno(codigos);
+                s.aplicar(codigos[azar.menorQue((uint32_t)n)]);
+            }
+
+            // Retropropagación: victoria para los nodos del ganador
+            for (int i = 0; i < largo; ++i) {
+                Nodo& nd = arbol[camino[i]];
+                nd.visitas++;
+                nd.victorias += nd.jugador == s.ganador;
             }
         }
-        cout << "Gracias por jugar. ¡Hasta la próxima!\n";
+        for (int h = arbol[0].primerHijo; h >= 0; h = arbol[h].hermano)
+            visitasRaiz[arbol[h].codigo] += arbol[h].visitas;
     }
-}; // fin clase PartidaDomino
 
+public:
+    // hilos = 0: todos los núcleos; con iteracionesPorHilo > 0 se ignora
+    // el tiempo y la búsqueda es reproducible
+    ParticipanteISMCTS(const string& nombre_, unsigned hilos_ = 0, double milisegundos_ = 20,
+                       long long iteracionesPorHilo_ = 0)
+        : ParticipanteHeuristico(nombre_), hilos(hilos_ ? hilos_ : max(1u, thread::hardware_concurrency())),
+          milisegundos(milisegundos_), iteracionesPorHilo(iteracionesPorHilo_) {
+        estadisticas.hilos = hilos;
+    }
+
+    int elegirJugada(const EstadoVisible& estado, const Jugada* legales, int total) override {
+        if (total == 1) return 0;
+        if (estado.totalJugadores < 2) return ParticipanteHeuristico::elegirJugada(estado, legales, total);
+        auto inicio = chrono::steady_clock::now();
+        auto limite = inicio + chrono::microseconds((long long)(milisegundos * 1000));
+
+        // Semillas sacadas del azar de la partida: misma partida, misma búsqueda
+        vector<uint64_t> semillas(hilos);
+        for (auto& s : semillas) s = (*estado.azar)();
+        vector<array<int, 64>> visitas(hilos);
+        vector<long long> iteraciones(hilos, 0);
+        auto trabajar = [&](unsigned h) {
+            visitas[h].fill(0);
+            buscar(estado, semillas[h], limite, iteraciones[h], visitas[h].data());
+        };
+        vector<thread> grupo;
+        for (unsigned h = 1; h < hilos; ++h) grupo.emplace_back(trabajar, h);
+        trabajar(0);
+        for (auto& t : grupo) t.join();
+
+        // La jugada más visitada sumando todos los árboles
+        int mejor = 0, mejorVisitas = -1;
+        bool mismoValor = estado.extremoIzq >= 0 && estado.extremoIzq == estado.extremoDer;
+        for (int i = 0; i < total; ++i) {
+            int lado = mismoValor ? 1 : legales[i].lado;
+            int codigo = legales[i].pieza | lado << 5, suma = 0;
+            for (unsigned h = 0; h < hilos; ++h) suma += visitas[h][codigo];
+            if (suma > mejorVisitas) { mejorVisitas = suma; mejor = i; }
+        }
+
+        estadisticas.decisiones++;
+        for (long long n : iteraciones) estadisticas.iteraciones += n;
+        estadisticas.segundos += chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+        return mejor;
+    }
+
+    const Estadisticas& obtenerEstadisticas() const { return estadisticas; }
+    void reiniciarEstadisticas() { estadisticas = Estadisticas(); estadisticas.hilos = hilos; }
+};
+
+// =========================
+// Registro binario de partidas
+// Formato (un archivo puede contener muchas partidas seguidas):
+//   cabecera: "DOMR" + versión (1 byte)
+//   inicio:   0xB0, jugadores (1 byte), las 28 piezas barajadas (1 byte
+//             cada una, el índice 0 es el fondo del pozo). El reparto
+//             sale de aquí: 7 rondas sacando del final, un jugador a la vez
+//   jugada:   0b0VLPPPPP (P = pieza 0..27, L = lado 0 izq / 1 der,
+//             V = colocada volteada respecto a [menor|mayor])
+//   robo:     0x80 | pieza
+//   pase:     0xA0
+//   fin:      0xC0 | bloqueo
+// Cada movimiento ocupa un byte. El turno no se anota: cada jugador roba
+// cero o más veces y luego juega o pasa, y el turno avanza. Los puntos
+// tampoco: salen de las manos que quedan al reproducir hasta el fin.
+// =========================
+const char FIRMA_REGISTRO[4] = {'D', 'O', 'M', 'R'};
+const uint8_t VERSION_REGISTRO = 1;
+const size_t TAM_CABECERA_REGISTRO = 5;
+const size_t TAM_INICIO_PARTIDA = 2 + TOTAL_PIEZAS;
+const uint8_t EVENTO_ROBO = 0x80;
+const uint8_t EVENTO_PASE = 0xA0;
+const uint8_t EVENTO_INICIO = 0xB0;
+const uint8_t EVENTO_FIN = 0xC0;
+
+// =========================
+// EscritorRegistro
+// Acumula los eventos en un búfer y lo vuelca al archivo cuando se llena
+// (o al llamar a vaciar/cerrar): escribir un movimiento es guardar un byte.
+// =========================
+class EscritorRegistro {
+private:
+    FILE* archivo = nullptr;
+    vector<uint8_t> bufer;
+    size_t usados = 0;
+    long long partidas = 0;
+    long long movimientos = 0;
+    long long bytesVolcados = 0;
+    bool correcto = false;
+
+    // Vacía el búfer si no caben n bytes más
+    void reservar(size_t n) {
+        if (usados + n > bufer.size()) vaciar();
+    }
+
+public:
+    static const size_t TAM_BUFER = 1 << 16;
+
+    // Constructor: crea (o trunca) el archivo y escribe la cabecera
+    explicit EscritorRegistro(const string& ruta) : bufer(TAM_BUFER) {
+        archivo = fopen(ruta.c_str(), "wb");
+        correcto = archivo != nullptr;
+        memcpy(bufer.data(), FIRMA_REGISTRO, sizeof(FIRMA_REGISTRO));
+        bufer[4] = VERSION_REGISTRO;
+        usados = TAM_CABECERA_REGISTRO;
+    }
+
+    // Destructor: vuelca lo pendiente y cierra
+    ~EscritorRegistro() { cerrar(); }
+
+    EscritorRegistro(const EscritorRegistro&) = delete;
+    EscritorRegistro& operator=(const EscritorRegistro&) = delete;
+
+    bool valido() const { return correcto; }
+
+    // Nueva partida: jugadores y orden del pozo barajado (28 identificadores)
+    void iniciarPartida(int jugadores, const uint8_t* barajado) {
+        reservar(TAM_INICIO_PARTIDA);
+        bufer[usados++] = EVENTO_INICIO;
+        bufer[usados++] = (uint8_t)jugadores;
+        memcpy(&bufer[usados], barajado, TOTAL_PIEZAS);
+        usados += TOTAL_PIEZAS;
+        ++partidas;
+    }
+
+    // El jugador de turno roba la pieza indicada del pozo
+    void robo(int pieza) {
+        reservar(1);
+        bufer[usados++] = (uint8_t)(EVENTO_ROBO | pieza);
+        ++movimientos;
+    }
+
+    // El jugador de turno coloca una pieza en un lado (0 izq, 1 der)
+    void jugada(int pieza, int lado, bool volteada) {
+        reservar(1);
+        bufer[usados++] = (uint8_t)(pieza | lado << 5 | (int)volteada << 6);
+        ++movimientos;
+    }
+
+    // El jugador de turno pasa
+    void pase() {
+        reservar(1);
+        bufer[usados++] = EVENTO_PASE;
+        ++movimientos;
+    }
+
+    // Fin de la partida (por dominó o por bloqueo)
+    void finPartida(bool bloqueo) {
+        reservar(1);
+        bufer[usados++] = (uint8_t)(EVENTO_FIN | (int)bloqueo);
+    }
+
+    // Escribe el búfer en el archivo; false si hubo algún error de escritura.
+    // Sin archivo (no se pudo abrir o ya se cerró) el búfer se descarta,
+    // así los eventos siguientes nunca escriben fuera de él
+    bool vaciar() {
+        if (usados == 0) return correcto;
+        if (archivo) {
+            if (fwrite(bufer.data(), 1, usados, archivo) != usados) correcto = false;
+            bytesVolcados += (long long)usados;
+        }
+        usados = 0;
+        return correcto;
+    }
+
+    // Vuelca lo pendiente y cierra el archivo
+    bool cerrar() {
+        if (!archivo) return correcto;
+        vaciar();
+        if (fclose(archivo) != 0) correcto = false;
+        archivo = nullptr;
+        return correcto;
+    }
+
+    // Partidas, movimientos y bytes registrados hasta ahora
+    long long obtenerPartidas() const { return partidas; }
+    long long obtenerMovimientos() const { return movimientos; }
+    long long obtenerBytes() const { return bytesVolcados + (long long)usados; }
+};
+
+// =========================
+// Archivo de solo lectura mapeado en memoria (en Windows se lee completo)
+// =========================
+class ArchivoMapeado {
+private:
+    const uint8_t* datos = nullptr;
+    size_t tamano = 0;
+#if defined(_WIN32) || defined(_WIN64)
+    vector<uint8_t> contenido;
+#endif
+
+public:
+    // Constructor: abre y mapea el archivo; valido() indica si se pudo
+    explicit ArchivoMapeado(const string& ruta) {
+#if defined(_WIN32) || defined(_WIN64)
+        ifstream archivo(ruta, ios::binary);
+        if (!archivo) return;
+        contenido.assign(istreambuf_iterator<char>(archivo), istreambuf_iterator<char>());
+        datos = contenido.data();
+        tamano = contenido.size();
+#else
+        int descriptor = open(ruta.c_str(), O_RDONLY);
+        if (descriptor < 0) return;
+        struct stat info;
+        if (fstat(descriptor, &info) == 0 && info.st_size > 0) {
+            void* mapa = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (mapa != MAP_FAILED) {
+                madvise(mapa, (size_t)info.st_size, MADV_SEQUENTIAL);
+                datos = (const uint8_t*)mapa;
+                tamano = (size_t)info.st_size;
+            }
+        }
+        close(descriptor);
+#endif
+    }
+
+    // Destructor: libera el mapeo
+    ~ArchivoMapeado() {
+#if !defined(_WIN32) && !defined(_WIN64)
+        if (datos) munmap((void*)datos, tamano);
+#endif
+    }
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    bool valido() const { return datos != nullptr; }
+    const uint8_t* bytes() const { return datos; }
+    size_t obtenerTamano() const { return tamano; }
+};
+
+// =========================
+// LectorRegistro
+// Mapea un registro y localiza dónde empieza y termina cada partida.
+// Una partida sin evento de fin (archivo cortado) no se indexa.
+// =========================
+class LectorRegistro {
+private:
+    ArchivoMapeado archivo;
+    vector<size_t> inicios;   // Desplazamiento del evento de inicio de cada partida
+    vector<size_t> finales;   // Desplazamiento justo después del evento de fin
+    bool correcto = false;
+    bool truncado = false;
+
+public:
+    explicit LectorRegistro(const string& ruta) : archivo(ruta) {
+        if (!archivo.valido() || archivo.obtenerTamano() < TAM_CABECERA_REGISTRO) return;
+        const uint8_t* d = archivo.bytes();
+        size_t n = archivo.obtenerTamano();
+        if (memcmp(d, FIRMA_REGISTRO, sizeof(FIRMA_REGISTRO)) != 0 || d[4] != VERSION_REGISTRO) return;
+
+        size_t pos = TAM_CABECERA_REGISTRO;
+        while (pos < n) {
+            if (d[pos] != EVENTO_INICIO) return;  // Formato inválido
+            size_t inicio = pos;
+            pos += TAM_INICIO_PARTIDA;
+            // Los eventos de fin (0xC0/0xC1) no aparecen en otros bytes
+            while (pos < n && (d[pos] & 0xFE) != EVENTO_FIN) ++pos;
+            if (pos >= n) { truncado = true; break; }
+            inicios.push_back(inicio);
+            finales.push_back(++pos);
+        }
+        correcto = true;
+    }
+
+    bool valido() const { return correcto; }
+    bool estaTruncado() const { return truncado; }
+    size_t totalPartidas() const { return inicios.size(); }
+
+    // Bytes de la partida i (desde su evento de inicio hasta el de fin)
+    const uint8_t* datosPartida(size_t i) const { return archivo.bytes() + inicios[i]; }
+    size_t tamanoPartida(size_t i) const { return finales[i] - inicios[i]; }
+};
+
+// =========================
+// ReproductorPartida
+// Rehace una partida registrada movimiento a movimiento: manos como
+// máscaras, pozo como arreglo y la mesa en un arreglo fijo que crece
+// hacia ambos lados desde el centro. Cada movimiento se valida (la pieza
+// está en la mano, encaja en el extremo, el robo es la pieza de arriba
+// del pozo); ante un evento inválido se detiene y marca el error.
+// =========================
+class ReproductorPartida {
+private:
+    const uint8_t* datos = nullptr;
+    size_t tamano = 0;
+    size_t posicion = 0;             // Siguiente byte por leer
+    int totalJugadores = 0;
+    uint8_t barajado[TOTAL_PIEZAS];
+    int tamPozo = 0;
+    uint32_t manos[MAX_JUGADORES];
+    uint8_t mesaIzq[2 * TOTAL_PIEZAS + 1];  // Lado izquierdo de cada pieza en mesa
+    uint8_t mesaDer[2 * TOTAL_PIEZAS + 1];  // Lado derecho de cada pieza en mesa
+    int primera = TOTAL_PIEZAS;      // Índice de la pieza más a la izquierda
+    int finMesa = TOTAL_PIEZAS;      // Uno después de la pieza más a la derecha
+    int turno = 0;
+    long long movimiento = 0;
+    bool terminada = false;
+    bool bloqueada = false;
+    bool erronea = false;
+
+    bool fallar() {
+        erronea = true;
+        return false;
+    }
+
+public:
+    // Prepara la reproducción de una partida (posición: recién repartida)
+    bool cargar(const uint8_t* datos_, size_t tamano_) {
+        datos = datos_;
+        tamano = tamano_;
+        return reiniciar();
+    }
+
+    // Vuelve al reparto inicial de la partida cargada
+    bool reiniciar() {
+        erronea = terminada = bloqueada = false;
+        movimiento = 0;
+        turno = 0;
+        primera = finMesa = TOTAL_PIEZAS;
+        if (!datos || tamano < TAM_INICIO_PARTIDA || datos[0] != EVENTO_INICIO) return fallar();
+        totalJugadores = datos[1];
+        if (totalJugadores < 2 || totalJugadores > MAX_JUGADORES) return fallar();
+        uint32_t vistas = 0;
+        for (int i = 0; i < TOTAL_PIEZAS; ++i) {
+            barajado[i] = datos[2 + i];
+            if (barajado[i] >= TOTAL_PIEZAS) return fallar();
+            vistas |= 1u << barajado[i];
+        }
+        if (vistas != TODAS_LAS_PIEZAS) return fallar();  // Debe ser una permutación
+
+        tamPozo = TOTAL_PIEZAS;
+        for (int j = 0; j < totalJugadores; ++j) manos[j] = 0;
+        for (int r = 0; r < PIEZAS_POR_MANO; ++r)
+            for (int j = 0; j < totalJugadores; ++j)
+                manos[j] |= 1u << barajado[--tamPozo];
+        posicion = TAM_INICIO_PARTIDA;
+        return true;
+    }
+
+    // Aplica el siguiente evento; false al llegar al fin o ante un error
+    bool avanzar() {
+        if (terminada || erronea || posicion >= tamano) return false;
+        uint8_t e = datos[posicion];
+        if (e < EVENTO_ROBO) {
+            int pieza = e & 31, lado = (e >> 5) & 1;
+            uint32_t bit = 1u << pieza;
+            if (pieza >= TOTAL_PIEZAS || !(manos[turno] & bit)) return fallar();
+            uint8_t a = tablaPiezas.izquierdo[pieza], b = tablaPiezas.derecho[pieza];
+            if (e & 0x40) swap(a, b);
+            if (primera == finMesa) {
+                ++finMesa;
+            } else if (lado == 0) {
+                if (b != mesaIzq[primera]) return fallar();
+                --primera;
+            } else {
+                if (a != mesaDer[finMesa - 1]) return fallar();
+                ++finMesa;
+            }
+            int destino = lado == 0 ? primera : finMesa - 1;
+            mesaIzq[destino] = a;
+            mesaDer[destino] = b;
+            manos[turno] &= ~bit;
+            turno = turno + 1 == totalJugadores ? 0 : turno + 1;
+        } else if ((e & 0xE0) == EVENTO_ROBO) {
+            if (tamPozo == 0 || barajado[tamPozo - 1] != (e & 31)) return fallar();
+            manos[turno] |= 1u << barajado[--tamPozo];
+        } else if (e == EVENTO_PASE) {
+            turno = turno + 1 == totalJugadores ? 0 : turno + 1;
+        } else if ((e & 0xFE) == EVENTO_FIN) {
+            terminada = true;
+            bloqueada = e & 1;
+            ++posicion;
+            return false;
+        } else {
+            return fallar();
+        }
+        ++posicion;
+        ++movimiento;
+        return true;
+    }
+
+    // Lleva la reproducción al estado tras 'destino' movimientos
+    // (hacia atrás vuelve a empezar desde el reparto)
+    bool irA(long long destino) {
+        if (destino < movimiento && !reiniciar()) return false;
+        while (movimiento < destino && avanzar()) {}
+        return movimiento == destino;
+    }
+
+    // Reproduce hasta el final; false si algún evento era inválido
+    bool reproducirTodo() {
+        while (avanzar()) {}
+        return terminada && !erronea;
+    }
+
+    // Estado en la posición actual
+    long long movimientoActual() const { return movimiento; }
+    int jugadorDeTurno() const { return turno; }
+    int jugadores() const { return totalJugadores; }
+    uint32_t manoDe(int jugador) const { return manos[jugador]; }
+    int piezasEnPozo() const { return tamPozo; }
+    int piezasEnMesa() const { return finMesa - primera; }
+    int extremoIzq() const { return primera == finMesa ? -1 : mesaIzq[primera]; }
+    int extremoDer() const { return primera == finMesa ? -1 : mesaDer[finMesa - 1]; }
+    bool partidaTerminada() const { return terminada; }
+    bool terminoPorBloqueo() const { return bloqueada; }
+    bool tieneError() const { return erronea; }
+
+    // Puntos del ganador (la suma de las demás manos); en un bloqueo gana
+    // la menor suma, así que es el total menos la menor
+    int puntosGanador() const {
+        int total = 0, menor = INT_MAX;
+        for (int j = 0; j < totalJugadores; ++j) {
+            int s = puntosDe(manos[j]);
+            total += s;
+            menor = min(menor, s);
+        }
+        return total - menor;
+    }
+
+    // Mesa como la usa PartidaDomino (izquierda a derecha)
+    deque<PiezaDomino> tablero() const {
+        deque<PiezaDomino> mesa;
+        for (int i = primera; i < finMesa; ++i) mesa.emplace_back(mesaIzq[i], mesaDer[i]);
+        return mesa;
+    }
+};
+
+// =========================
+// Telemetría de PartidaDomino
+// Histogramas de latencia estilo HDR y contadores del bucle de juego.
+// Se activa al compilar con -DDOMINO_TELEMETRIA=1 (medir cuesta cerca
+// del 10 % de una ronda). Desactivada, los puntos de medición quedan
+// dentro de "if constexpr" descartados, sin lectura del reloj, y la
+// partida guarda una TelemetriaVacia en lugar de los histogramas.
+// =========================
+#ifndef DOMINO_TELEMETRIA
+    #define DOMINO_TELEMETRIA 0
+#endif
+constexpr bool TELEMETRIA_ACTIVA = DOMINO_TELEMETRIA != 0;
+
+// Histograma log-lineal: valores menores que 16 exactos y, desde ahí,
+// 16 cubetas por cada potencia de dos (error relativo menor al 6,25 %).
+// Registrar es un desplazamiento y un incremento, sin reservar memoria.
+class HistogramaLatencia {
+private:
+    static const int SUBCUBETAS = 16;
+    static const int CUBETAS = (64 - 3) * SUBCUBETAS;
+    uint64_t cuentas[CUBETAS];
+    uint64_t total = 0;
+    uint64_t suma = 0;
+    uint64_t minimo = UINT64_MAX;
+    uint64_t maximo = 0;
+
+    static int cubeta(uint64_t valor) {
+        if (valor < SUBCUBETAS) return (int)valor;
+        int exponente = bitMasAlto(valor);  // >= 4
+        return (exponente - 3) * SUBCUBETAS + (int)((valor >> (exponente - 4)) & (SUBCUBETAS - 1));
+    }
+
+    // Mayor valor que cae en la cubeta (como informa HDR)
+    static uint64_t limiteSuperior(int indice) {
+        if (indice < SUBCUBETAS) return (uint64_t)indice;
+        int exponente = indice / SUBCUBETAS + 3, sub = indice % SUBCUBETAS;
+        return ((uint64_t)(SUBCUBETAS + sub + 1) << (exponente - 4)) - 1;
+    }
+
+public:
+    HistogramaLatencia() : cuentas() {}
+
+    void registrar(uint64_t valor) {
+        cuentas[cubeta(valor)]++;
+        total++;
+        suma += valor;
+        minimo = min(minimo, valor);
+        maximo = max(maximo, valor);
+    }
+
+    // Valor bajo el que queda el p % de las muestras
+    uint64_t percentil(double p) const {
+        if (total == 0) return 0;
+        uint64_t objetivo = max<uint64_t>(1, (uint64_t)ceil(p / 100.0 * (double)total)), acumulado = 0;
+        for (int i = 0; i < CUBETAS; ++i) {
+            acumulado += cuentas[i];
+            if (acumulado >= objetivo) return min(maximo, limiteSuperior(i));
+        }
+        return maximo;
+    }
+
+    // Acumula otro histograma (por ejemplo, el de otro jugador)
+    void sumar(const HistogramaLatencia& otro) {
+        for (int i = 0; i < CUBETAS; ++i) cuentas[i] += otro.cuentas[i];
+        total += otro.total;
+        suma += otro.suma;
+        minimo = min(minimo, otro.minimo);
+        maximo = max(maximo, otro.maximo);
+    }
+
+    uint64_t cantidad() const { return total; }
+    uint64_t sumaTotal() const { return suma; }
+    double promedio() const { return total ? (double)suma / (double)total : 0; }
+
+    // Resumen como objeto JSON
+    string comoJSON() const {
+        ostringstream s;
+        s << "{\"cuenta\": " << total << ", \"promedio\": " << fixed << setprecision(1) << promedio()
+          << ", \"min\": " << (total ? minimo : 0) << ", \"p50\": " << percentil(50) << ", \"p90\": "
+          << percentil(90) << ", \"p99\": " << percentil(99) << ", \"p999\": " << percentil(99.9)
+          << ", \"max\": " << maximo << "}";
+        return s.str();
+    }
+};
+
+// Texto como cadena JSON (comillas, barras y caracteres de control escapados)
+inline string cadenaJSON(const string& texto) {
+    string r = "\"";
+    for (unsigned char c : texto) {
+        if (c == '"' || c == '\\') { r += '\\'; r += (char)c; }
+        else if (c < 0x20) { char u[8]; snprintf(u, sizeof(u), "\\u%04x", c); r += u; }
+        else r += (char)c;
+    }
+    return r + "\"";
+}
+
+// Contadores de un jugador
+struct TelemetriaJugador {
+    string nombre;
+    long long turnos = 0;
+    long long jugadas = 0;
+    long long robos = 0;
+    long long pases = 0;
+    HistogramaLatencia realizarJugada;  // Nanosegundos por llamada
+};
+
+// Contadores de toda la partida
+struct TelemetriaPartida {
+    long long rondas = 0;
+    long long turnos = 0;
+    long long robos = 0;
+    long long pases = 0;
+    long long bloqueos = 0;
+    HistogramaLatencia turnosPorRonda;
+    HistogramaLatencia duracionRonda;    // Nanosegundos por ronda
+    vector<TelemetriaJugador> jugadores;
+    long long turnosEnRonda = 0;         // Turnos de la ronda en curso
+    chrono::steady_clock::time_point inicioRonda;
+
+    // Prepara los contadores por jugador (y descarta los anteriores)
+    void reiniciar(const vector<string>& nombres) {
+        *this = TelemetriaPartida();
+        for (const auto& n : nombres) {
+            jugadores.emplace_back();
+            jugadores.back().nombre = n;
+        }
+    }
+
+    void empezarRonda() {
+        turnosEnRonda = 0;
+        inicioRonda = chrono::steady_clock::now();
+    }
+
+    // Un turno: cuánto tardó realizarJugada, cuántas piezas robó y si jugó
+    void registrarTurno(int jugador, chrono::steady_clock::time_point antes, long long robadas, bool jugo) {
+        uint64_t ns = (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - antes).count();
+        turnos++;
+        turnosEnRonda++;
+        robos += robadas;
+        pases += !jugo;
+        TelemetriaJugador& j = jugadores[jugador];
+        j.realizarJugada.registrar(ns);
+        j.turnos++;
+        j.robos += robadas;
+        j.jugadas += jugo;
+        j.pases += !jugo;
+    }
+
+    void terminarRonda(bool bloqueo) {
+        rondas++;
+        bloqueos += bloqueo;
+        turnosPorRonda.registrar((uint64_t)turnosEnRonda);
+        duracionRonda.registrar((uint64_t)chrono::duration_cast<chrono::nanoseconds>(
+            chrono::steady_clock::now() - inicioRonda).count());
+    }
+
+    // Latencia de realizarJugada de todos los jugadores (se suma al pedirla)
+    HistogramaLatencia realizarJugada() const {
+        HistogramaLatencia total;
+        for (const auto& j : jugadores) total.sumar(j.realizarJugada);
+        return total;
+    }
+
+    // Instantánea completa en JSON
+    string comoJSON() const {
+        ostringstream s;
+        s << "{\n  \"rondas\": " << rondas << ",\n  \"turnos\": " << turnos << ",\n  \"robos\": " << robos
+          << ",\n  \"pases\": " << pases << ",\n  \"bloqueos\": " << bloqueos
+          << ",\n  \"turnosPorRonda\": " << turnosPorRonda.comoJSON()
+          << ",\n  \"duracionRondaNs\": " << duracionRonda.comoJSON()
+          << ",\n  \"realizarJugadaNs\": " << realizarJugada().comoJSON() << ",\n  \"jugadores\": [";
+        for (size_t i = 0; i < jugadores.size(); ++i) {
+            const TelemetriaJugador& j = jugadores[i];
+            s << (i ? ",\n" : "\n") << "    {\"nombre\": " << cadenaJSON(j.nombre) << ", \"turnos\": " << j.turnos
+              << ", \"jugadas\": " << j.jugadas << ", \"robos\": " << j.robos << ", \"pases\": " << j.pases
+              << ", \"tiempoTotalNs\": " << j.realizarJugada.sumaTotal()
+              << ", \"realizarJugadaNs\": " << j.realizarJugada.comoJSON() << "}";
+        }
+        s << "\n  ]\n}\n";
+        return s.str();
+    }
+};
+
+// Lo que guarda PartidaDomino con la telemetría desactivada: las mismas
+// operaciones, sin datos ni reservas de memoria
+struct TelemetriaVacia {
+    static constexpr long long turnos = 0;
+
+    void reiniciar(const vector<string>&) {}
+    void empezarRonda() {}
+    void registrarTurno(int, chrono::steady_clock::time_point, long long, bool) {}
+    void terminarRonda(bool) {}
+    string comoJSON() const { return "{\"telemetria\": \"desactivada al compilar\"}\n"; }
+};
+
+using TelemetriaEnUso = conditional_t<TELEMETRIA_ACTIVA, TelemetriaPartida, TelemetriaVacia>;
+
+// =========================
+// Estado plano de PartidaDomino
+// Una partida guardada en un bloque fijo de bytes, sin punteros ni
+// contenedores: el mazo (orden de la última barajada), el pozo, la mesa,
+// las manos, el turno y la puntuación de cada jugador. Se copia con
+// memcpy (clonar un estado cuesta lo mismo que copiar ~1 KB) y se
+// guarda en disco tal cual está en memoria.
+// Cada pieza ocupa un byte, izquierdo << 4 | derecho, así se conserva
+// cómo quedó girada en la mesa (sirve hasta el doble quince).
+// Los jugadores no se guardan (son objetos polimórficos): solo sus
+// nombres, para comprobar al restaurar que son los mismos asientos.
+// Tampoco el generador de las barajadas: la próxima usa el de la partida
+// donde se restaura. Sí se guardan el azar de los jugadores y los valores
+// que cada uno mostró no tener, para que una ronda retomada a medias
+// siga igual que la original.
+// =========================
+const char FIRMA_ESTADO[4] = {'D', 'O', 'M', 'E'};
+const uint32_t VERSION_ESTADO = 3;
+
+struct EstadoPartida {
+    static const int MAX_PIEZAS = MAX_PIEZAS_CONJUNTO;
+    static const int TAM_NOMBRE = 64;   // Incluye el '\0' final (los nombres largos se recortan)
+
+    char firma[4];
+    uint32_t version;
+    uint64_t azarJugadores;         // Estado del GeneradorRapido de los jugadores
+    uint8_t valorMaximo;
+    uint8_t totalJugadores;
+    uint8_t turno;                  // Jugador de turno (ronda en curso)
+    uint8_t pasesConsecutivos;
+    uint8_t rondaEnCurso;           // 0: entre rondas (manos y mesa de la última ronda)
+    uint8_t tamMazo;
+    uint8_t tamPozo;
+    uint8_t tamTablero;
+    uint8_t tamMano[MAX_JUGADORES];
+    uint8_t valoresAusentes[MAX_JUGADORES];  // Lo que la mesa sabe de cada mano (doble seis)
+    int32_t puntuacion[MAX_JUGADORES];
+    char nombres[MAX_JUGADORES][TAM_NOMBRE];
+    uint8_t mazo[MAX_PIEZAS];
+    uint8_t pozo[MAX_PIEZAS];       // Se roba del final
+    uint8_t tablero[MAX_PIEZAS];    // De izquierda a derecha
+    uint8_t manos[MAX_JUGADORES][MAX_PIEZAS];
+
+    static uint8_t empacar(const PiezaDomino& p) {
+        return (uint8_t)(p.obtenerIzquierdo() << 4 | p.obtenerDerecho());
+    }
+    static PiezaDomino desempacar(uint8_t b) { return PiezaDomino(b >> 4, b & 15); }
+
+    // Comprueba la cabecera y que las piezas formen un juego completo
+    // (cada una una sola vez entre pozo, mesa y manos, y la mesa encadenada)
+    bool esValido() const {
+        if (memcmp(firma, FIRMA_ESTADO, sizeof(firma)) != 0 || version != VERSION_ESTADO) return false;
+        int total = piezasDelConjunto(valorMaximo);
+        if (piezasPorManoPara(valorMaximo) == 0 || totalJugadores < 2 || totalJugadores > MAX_JUGADORES) return false;
+        if (turno >= totalJugadores || pasesConsecutivos > totalJugadores || rondaEnCurso > 1) return false;
+        if (tamMazo != 0 && tamMazo != total) return false;
+        // Ningún contenedor puede tener más piezas que el juego (los
+        // arreglos son de MAX_PIEZAS y marcar los recorre)
+        if (tamPozo > total || tamTablero > total) return false;
+        for (int j = 0; j < totalJugadores; ++j)
+            if (tamMano[j] > total || nombres[j][TAM_NOMBRE - 1] != '\0' || nombres[j][0] == '\0' ||
+                valoresAusentes[j] >> (VALOR_MAXIMO + 1))
+                return false;
+
+        // Marca cada pieza vista; 'vistas' guarda el contenedor que la tuvo
+        uint8_t vistas[MAX_PIEZAS] = {0};
+        auto marcar = [&](const uint8_t* piezas, int n) {
+            for (int i = 0; i < n; ++i) {
+                int izq = piezas[i] >> 4, der = piezas[i] & 15;
+                if (izq > valorMaximo || der > valorMaximo) return false;
+                int id = PiezaDomino(izq, der).identificador(valorMaximo);
+                if (vistas[id]) return false;
+                vistas[id] = 1;
+            }
+            return true;
+        };
+        int enJuego = tamPozo + tamTablero;
+        if (!marcar(pozo, tamPozo) || !marcar(tablero, tamTablero)) return false;
+        for (int j = 0; j < totalJugadores; ++j) {
+            enJuego += tamMano[j];
+            if (!marcar(manos[j], tamMano[j])) return false;
+        }
+        if (enJuego != total && !(enJuego == 0 && !rondaEnCurso)) return false;
+        for (int i = 0; i + 1 < tamTablero; ++i)
+            if ((tablero[i] & 15) != (tablero[i + 1] >> 4)) return false;
+
+        memset(vistas, 0, sizeof(vistas));
+        return marcar(mazo, tamMazo);
+    }
+
+    // Guarda la imagen en memoria del estado
+    bool guardar(const string& ruta) const {
+        FILE* archivo = fopen(ruta.c_str(), "wb");
+        if (!archivo) return false;
+        bool ok = fwrite(this, sizeof(*this), 1, archivo) == 1;
+        return fclose(archivo) == 0 && ok;
+    }
+
+    // Lee un estado guardado con guardar(); false si el archivo no es un estado válido
+    bool cargar(const string& ruta) {
+        FILE* archivo = fopen(ruta.c_str(), "rb");
+        if (!archivo) return false;
+        bool ok = fread(this, sizeof(*this), 1, archivo) == 1 && fgetc(archivo) == EOF;
+        fclose(archivo);
+        return ok && esValido();
+    }
+
+    // Ronda en curso de doble seis como EstadoSimulado (con todas las manos
+    // a la vista), para que un jugador de búsqueda la continúe desde aquí
+    bool aSimulado(EstadoSimulado& s) const {
+        if (!rondaEnCurso || valorMaximo != VALOR_MAXIMO) return false;
+        s.totalJugadores = totalJugadores;
+        for (int j = 0; j < totalJugadores; ++j) {
+            s.manos[j] = 0;
+            for (int i = 0; i < tamMano[j]; ++i) s.manos[j] |= desempacar(manos[j][i]).mascara();
+        }
+        for (int i = 0; i < tamPozo; ++i) s.pozo[i] = (uint8_t)desempacar(pozo[i]).identificador();
+        s.tamPozo = tamPozo;
+        s.extremoIzq = tamTablero ? tablero[0] >> 4 : -1;
+        s.extremoDer = tamTablero ? tablero[tamTablero - 1] & 15 : -1;
+        s.turno = turno;
+        s.pasesConsecutivos = pasesConsecutivos;
+        s.ganador = -1;
+        return true;
+    }
+};
+static_assert(is_trivially_copyable<EstadoPartida>::value, "EstadoPartida se copia con memcpy");
+
+// =========================
+// Clase PartidaDomino
+// Gestiona el flujo completo del juego: piezas, reparto, turnos, puntuación y rondas.
+// =========================
+class PartidaDomino {
+private:
+    vector<PiezaDomino> fabricaPiezas;    // Juego completo doble-valorMaximo (28 piezas en doble seis)
+    vector<PiezaDomino> pozo;             // Piezas restantes para robar
+    MesaDomino tablero;                   // Piezas colocadas en la mesa
+    vector<Participante*> jugadores;      // Lista de participantes (polimorfismo)
+    int puntuacionTotal[MAX_JUGADORES] = {0};  // Puntos acumulados por índice de jugador
+    int rangoNombre[MAX_JUGADORES] = {0};      // Posición de cada nombre en orden alfabético
+    int totalJugadores;                   // Número actual de jugadores
+    mt19937 generadorAleatorio;           // Motor de aleatorización
+    GeneradorRapido azarJugadores;        // Azar de los jugadores automáticos (sale de la semilla)
+    EscritorRegistro* registro = nullptr; // Registro binario opcional (no se libera aquí)
+    int valorMaximo = VALOR_MAXIMO;       // Juego doble-N en uso (6, 9, 12 o 15)
+    TelemetriaEnUso telemetria;           // Contadores y latencias (vacía sin DOMINO_TELEMETRIA)
+    int turnoActual = 0;                  // Jugador de turno en la ronda en curso
+    int pasesConsecutivos = 0;
+    uint8_t valoresAusentes[MAX_JUGADORES] = {0};  // Valores (bit v) que cada jugador mostró no tener
+    bool rondaEnCurso = false;
+    bool registrarRonda = false;          // La ronda en curso se está grabando en 'registro'
+    uint8_t barajado[TOTAL_PIEZAS];       // Orden inicial del pozo (para el registro)
+
+public:
+    // Constructor: inicializa el generador aleatorio con la hora actual
+    PartidaDomino() : PartidaDomino((unsigned)time(nullptr)) {}
+
+    // Constructor con semilla fija: la misma semilla repite las mismas
+    // barajadas y las mismas decisiones al azar de los jugadores automáticos
+    explicit PartidaDomino(unsigned semilla) {
+        generadorAleatorio.seed(semilla);
+        azarJugadores = GeneradorRapido((uint64_t)generadorAleatorio() << 32 | generadorAleatorio());
+    }
+
+    // Destructor: libera memoria de los jugadores
+    ~PartidaDomino() {
+        for (auto p : jugadores) delete p;
+        jugadores.clear();
+    }
+
+    // Elige el juego: doble seis (28 piezas, 7 por mano), doble nueve (55,
+    // 10), doble doce (91, 12) o doble quince (136, 15); false si no existe
+    bool configurarConjunto(int maximo) {
+        if (piezasPorManoPara(maximo) == 0) return false;
+        valorMaximo = maximo;
+        return true;
+    }
+
+    // Genera las piezas estándar de un juego doble-'maximo' (0-0 hasta N-N)
+    void generarConjuntoCompleto(int maximo = VALOR_MAXIMO) {
+        fabricaPiezas.clear();
+        for (int izq = 0; izq <= maximo; ++izq)
+            for (int der = izq; der <= maximo; ++der)
+                fabricaPiezas.emplace_back(izq, der);
+    }
+
+    // Baraja las piezas en su lugar y prepara el pozo. El conjunto solo se
+    // genera al cambiar de juego (barajar la permutación anterior es igual
+    // de uniforme) y el pozo reutiliza su capacidad: no se reserva memoria
+    void mezclarYPreparar() {
+        if ((int)fabricaPiezas.size() != piezasDelConjunto(valorMaximo)) generarConjuntoCompleto(valorMaximo);
+        shuffle(fabricaPiezas.begin(), fabricaPiezas.end(), generadorAleatorio);
+        pozo.assign(fabricaPiezas.begin(), fabricaPiezas.end()); // Copia completa al pozo
+    }
+
+    // Activa (o con nullptr desactiva) el registro binario de las rondas
+    void registrarEn(EscritorRegistro* escritor) { registro = escritor; }
+
+    // Solicita número y nombres de jugadores (2-4)
+    void configurarParticipantes() {
+        for (auto p : jugadores) delete p;
+        jugadores.clear();
+        rondaEnCurso = false;
+
+        cout << "Ingrese número de jugadores (2-4): ";
+        while (true) {
+            cin >> totalJugadores;
+            if (cin.fail() || totalJugadores < 2 || totalJugadores > 4) {
+                cout << "Número inválido. Ingrese entre 2 y 4: ";
+                cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n');
+            } else break;
+        }
+
+        for (int i = 0; i < totalJugadores; ++i) {
+            cout << "Nombre del jugador " << (i+1) << ": ";
+            string nombre;
+            cin >> ws; getline(cin, nombre);
+            if (nombre.empty()) nombre = "Jugador" + to_string(i+1);
+            Participante* p = new ParticipanteHumano(nombre);
+            jugadores.push_back(p);
+        }
+        prepararPuntajes();
+        reiniciarTelemetria();
+    }
+
+    // Configura jugadores ya creados (2-4, sin consola); la partida los libera
+    bool configurarParticipantes(const vector<Participante*>& nuevos) {
+        if (nuevos.size() < 2 || nuevos.size() > MAX_JUGADORES) return false;
+        for (auto p : jugadores) delete p;
+        jugadores = nuevos;
+        totalJugadores = (int)nuevos.size();
+        rondaEnCurso = false;
+        prepararPuntajes();
+        reiniciarTelemetria();
+        return true;
+    }
+
+    // Puntajes en cero y orden alfabético de los nombres (los repetidos,
+    // por asiento): desempata los bloqueos y ordena la tabla de puntajes
+    void prepararPuntajes() {
+        for (int i = 0; i < totalJugadores; ++i) {
+            puntuacionTotal[i] = 0;
+            rangoNombre[i] = 0;
+            for (int k = 0; k < totalJugadores; ++k) {
+                const string& a = jugadores[k]->obtenerNombre();
+                const string& b = jugadores[i]->obtenerNombre();
+                if (a < b || (a == b && k < i)) rangoNombre[i]++;
+            }
+        }
+    }
+
+    // Pone en cero la telemetría de los jugadores actuales
+    void reiniciarTelemetria() {
+        if constexpr (!TELEMETRIA_ACTIVA) return;
+        vector<string> nombres;
+        for (auto p : jugadores) nombres.push_back(p->obtenerNombre());
+        telemetria.reiniciar(nombres);
+    }
+
+    // Instantánea de la telemetría en JSON y acceso a los contadores
+    string telemetriaJSON() const { return telemetria.comoJSON(); }
+    const TelemetriaEnUso& obtenerTelemetria() const { return telemetria; }
+
+    // Reparte 7 piezas a cada jugador (más en los juegos grandes); el resto queda en el pozo
+    void distribuirPiezas() {
+        for (auto p : jugadores) {
+            p->limpiarMano();
+            p->reservarMano(piezasDelConjunto(valorMaximo), valorMaximo);
+        }
+        tablero.clear();
+
+        for (int r = 0; r < piezasPorManoPara(valorMaximo); ++r) {
+            for (auto p : jugadores) {
+                if (pozo.empty()) break;
+                PiezaDomino pieza = pozo.back(); pozo.pop_back();
+                p->tomarPieza(pieza);
+            }
+        }
+    }
+
+    // Resultado de jugarTurno()
+    enum ResultadoTurno { TURNO_SIGUE, TURNO_GANO, TURNO_BLOQUEO };
+
+    // Baraja, reparte y deja la ronda lista para el primer turno
+    void empezarRonda() {
+        mezclarYPreparar();
+        distribuirPiezas();
+
+        // El pozo solo se achica por el final, así que las piezas robadas
+        // en un turno salen de este orden inicial. El formato del registro
+        // es de doble seis: con juegos más grandes no se graba.
+        registrarRonda = registro && valorMaximo == VALOR_MAXIMO;
+        if (registrarRonda) {
+            for (int i = 0; i < TOTAL_PIEZAS; ++i) barajado[i] = (uint8_t)fabricaPiezas[i].identificador();
+            registro->iniciarPartida(totalJugadores, barajado);
+        }
+
+        turnoActual = 0;
+        pasesConsecutivos = 0;
+        memset(valoresAusentes, 0, sizeof(valoresAusentes));
+        rondaEnCurso = true;
+        if constexpr (TELEMETRIA_ACTIVA) telemetria.empezarRonda();
+    }
+
+    // Juega el turno de jugadores[turnoActual]; si la ronda termina, el
+    // turno no avanza (con TURNO_GANO, turnoActual es el ganador)
+    ResultadoTurno jugarTurno() {
+        Participante* jugadorActual = jugadores[turnoActual];
+
+        // Obtener valores de los extremos del tablero
+        int valIzq = -1, valDer = -1;
+        if (!tablero.empty()) {
+            valIzq = tablero.front().obtenerIzquierdo();
+            valDer = tablero.back().obtenerDerecho();
+        }
+
+        size_t pozoAntes = pozo.size();
+        int frenteAntes = tablero.empty() ? -1 : tablero.front().identificador();
+        chrono::steady_clock::time_point antesJugada;
+        if constexpr (TELEMETRIA_ACTIVA) antesJugada = chrono::steady_clock::now();
+        // Lo que cualquiera en la mesa sabe antes del turno
+        EstadoVisible visible;
+        visible.jugador = turnoActual;
+        visible.totalJugadores = totalJugadores;
+        for (int j = 0; j < totalJugadores; ++j) {
+            visible.piezasJugadores[j] = jugadores[j]->cantidadPiezas();
+            visible.valoresAusentes[j] = valoresAusentes[j];
+        }
+        visible.valorMaximo = valorMaximo;
+        visible.azar = &azarJugadores;
+        bool jugo = jugadorActual->realizarJugada(tablero, pozo, valIzq, valDer, visible);
+        // Como en SimuladorDomino: quien roba o pasa no tenía los valores de
+        // los extremos (lo sabido antes de robar deja de valer). Los bits
+        // solo alcanzan para el doble seis, el único juego que los usa
+        if (valorMaximo == VALOR_MAXIMO && valIzq >= 0) {
+            uint8_t valoresExtremos = (uint8_t)(1 << valIzq | 1 << valDer);
+            if (pozo.size() != pozoAntes) valoresAusentes[turnoActual] = valoresExtremos;
+            if (!jugo) valoresAusentes[turnoActual] |= valoresExtremos;
+        }
+        if constexpr (TELEMETRIA_ACTIVA)
+            telemetria.registrarTurno(turnoActual, antesJugada, (long long)(pozoAntes - pozo.size()), jugo);
+        if (registrarRonda) registrarTurno(barajado, pozoAntes, frenteAntes, jugo);
+        if (jugo) {
+            pasesConsecutivos = 0;
+            if (jugadorActual->cantidadPiezas() == 0) {
+                cout << "\n*** " << jugadorActual->obtenerNombre()
+                     << " se quedó sin piezas y gana la ronda! ***\n";
+                terminarRonda(false);
+                return TURNO_GANO;
+            }
+        } else {
+            pasesConsecutivos++;
+            cout << jugadorActual->obtenerNombre() << " pasó.\n";
+        }
+
+        // Detectar bloqueo: todos los jugadores pasaron consecutivamente
+        if (pasesConsecutivos >= totalJugadores) {
+            cout << "\n--- Estado de bloqueo: ninguno puede jugar ---\n";
+            terminarRonda(true);
+            return TURNO_BLOQUEO;
+        }
+
+        turnoActual = (turnoActual + 1) % totalJugadores;
+        return TURNO_SIGUE;
+    }
+
+    // Cierra la ronda en la telemetría y en el registro
+    void terminarRonda(bool bloqueo) {
+        rondaEnCurso = false;
+        if constexpr (TELEMETRIA_ACTIVA) telemetria.terminarRonda(bloqueo);
+        if (registrarRonda) { registro->finPartida(bloqueo); registro->vaciar(); }
+        registrarRonda = false;
+    }
+
+    // Ejecuta una ronda completa hasta que alguien gane o se bloquee (si
+    // hay una ronda a medias, por ejemplo restaurada, la continúa).
+    // Devuelve el índice del ganador, o -1 si hubo bloqueo
+    int ejecutarRonda() {
+        if (!rondaEnCurso) empezarRonda();
+        while (true) {
+            ResultadoTurno resultado = jugarTurno();
+            if (resultado == TURNO_GANO) return turnoActual;
+            if (resultado == TURNO_BLOQUEO) return -1;
+        }
+    }
+
+    bool hayRondaEnCurso() const { return rondaEnCurso; }
+
+    // Copia todo el estado de la partida en 'e' (ver EstadoPartida)
+    void capturarEstado(EstadoPartida& e) const {
+        memset(&e, 0, sizeof(e));
+        memcpy(e.firma, FIRMA_ESTADO, sizeof(e.firma));
+        e.version = VERSION_ESTADO;
+        e.valorMaximo = (uint8_t)valorMaximo;
+        e.totalJugadores = (uint8_t)totalJugadores;
+        e.turno = (uint8_t)turnoActual;
+        e.pasesConsecutivos = (uint8_t)pasesConsecutivos;
+        e.rondaEnCurso = rondaEnCurso;
+        e.azarJugadores = azarJugadores.estadoActual();
+        memcpy(e.valoresAusentes, valoresAusentes, sizeof(valoresAusentes));
+        e.tamMazo = (uint8_t)fabricaPiezas.size();
+        for (size_t i = 0; i < fabricaPiezas.size(); ++i) e.mazo[i] = EstadoPartida::empacar(fabricaPiezas[i]);
+        e.tamPozo = (uint8_t)pozo.size();
+        for (size_t i = 0; i < pozo.size(); ++i) e.pozo[i] = EstadoPartida::empacar(pozo[i]);
+        e.tamTablero = (uint8_t)tablero.size();
+        for (size_t i = 0; i < tablero.size(); ++i) e.tablero[i] = EstadoPartida::empacar(tablero[i]);
+        for (int j = 0; j < totalJugadores; ++j) {
+            const Participante* p = jugadores[j];
+            e.tamMano[j] = (uint8_t)p->cantidadPiezas();
+            for (int i = 0; i < p->cantidadPiezas(); ++i) e.manos[j][i] = EstadoPartida::empacar(p->verPieza(i));
+            p->obtenerNombre().copy(e.nombres[j], EstadoPartida::TAM_NOMBRE - 1);
+            e.puntuacion[j] = puntuacionTotal[j];
+        }
+    }
+
+    // Vuelve al estado 'e'; los jugadores actuales deben ser los mismos
+    // (cantidad y nombres) que al capturarlo. Una ronda restaurada a
+    // medias no se graba en el registro (le faltaría el comienzo).
+    bool restaurarEstado(const EstadoPartida& e) {
+        if (!e.esValido() || e.totalJugadores != jugadores.size()) return false;
+        for (int j = 0; j < e.totalJugadores; ++j)
+            if (jugadores[j]->obtenerNombre().compare(0, EstadoPartida::TAM_NOMBRE - 1, e.nombres[j]) != 0)
+                return false;
+
+        valorMaximo = e.valorMaximo;
+        fabricaPiezas.clear();
+        for (int i = 0; i < e.tamMazo; ++i) fabricaPiezas.push_back(EstadoPartida::desempacar(e.mazo[i]));
+        pozo.clear();
+        for (int i = 0; i < e.tamPozo; ++i) pozo.push_back(EstadoPartida::desempacar(e.pozo[i]));
+        tablero.clear();
+        for (int i = 0; i < e.tamTablero; ++i) tablero.push_back(EstadoPartida::desempacar(e.tablero[i]));
+        for (int j = 0; j < e.totalJugadores; ++j) {
+            Participante* p = jugadores[j];
+            p->limpiarMano();
+            for (int i = 0; i < e.tamMano[j]; ++i) p->tomarPieza(EstadoPartida::desempacar(e.manos[j][i]));
+            puntuacionTotal[j] = e.puntuacion[j];
+        }
+        azarJugadores = GeneradorRapido(e.azarJugadores);
+        memcpy(valoresAusentes, e.valoresAusentes, sizeof(valoresAusentes));
+        turnoActual = e.turno;
+        pasesConsecutivos = e.pasesConsecutivos;
+        rondaEnCurso = e.rondaEnCurso != 0;
+        registrarRonda = false;
+        if constexpr (TELEMETRIA_ACTIVA) if (rondaEnCurso) telemetria.empezarRonda();
+        return true;
+    }
+
+    // Anota en el registro lo que hizo el jugador de turno, comparando el
+    // pozo y la mesa con los de antes del turno
+    void registrarTurno(const uint8_t* barajado, size_t pozoAntes, int frenteAntes, bool jugo) {
+        for (size_t i = pozoAntes; i > pozo.size(); --i) registro->robo(barajado[i - 1]);
+        if (!jugo) {
+            registro->pase();
+            return;
+        }
+        // La pieza nueva está al frente solo si se colocó a la izquierda
+        bool izquierda = frenteAntes >= 0 && tablero.front().identificador() != frenteAntes;
+        const PiezaDomino& colocada = izquierda ? tablero.front() : tablero.back();
+        int id = colocada.identificador();
+        registro->jugada(id, izquierda ? 0 : 1, colocada.obtenerIzquierdo() != tablaPiezas.izquierdo[id]);
+    }
+
+    // Calcula puntos de la ronda y actualiza acumulados; recibe el
+    // ganador (-1: bloqueo) y devuelve quién se lleva los puntos
+    int procesarPuntuacion(int ganador) {
+        int sumasPips[MAX_JUGADORES];
+        int totalPips = 0;
+        for (int j = 0; j < totalJugadores; ++j) {
+            sumasPips[j] = jugadores[j]->puntosEnMano();
+            totalPips += sumasPips[j];
+        }
+
+        bool bloqueo = ganador < 0;
+        if (bloqueo) {
+            // Bloqueo: gana quien tenga menor suma de pips (empates: el nombre menor)
+            ganador = 0;
+            for (int j = 1; j < totalJugadores; ++j)
+                if (sumasPips[j] < sumasPips[ganador] ||
+                    (sumasPips[j] == sumasPips[ganador] && rangoNombre[j] < rangoNombre[ganador]))
+                    ganador = j;
+        }
+        // El ganador suma los pips de los demás
+        int puntos = totalPips - sumasPips[ganador];
+        puntuacionTotal[ganador] += puntos;
+        const string& nombre = jugadores[ganador]->obtenerNombre();
+        if (bloqueo) cout << "Bloqueo: gana " << nombre << " con menor total (" << sumasPips[ganador] << ").\n";
+        cout << nombre << " obtiene " << puntos << " puntos de esta ronda.\n";
+        return ganador;
+    }
+
+    // Puntos acumulados del jugador con ese índice
+    int puntajeDe(int jugador) const { return puntuacionTotal[jugador]; }
+
+    // Muestra los puntajes acumulados actuales (en orden alfabético)
+    void mostrarPuntajes() const {
+        cout << "\n=== PUNTAJES ACUMULADOS ===\n";
+        for (int r = 0; r < totalJugadores; ++r)
+            for (int j = 0; j < totalJugadores; ++j)
+                if (rangoNombre[j] == r) cout << " " << jugadores[j]->obtenerNombre() << ": " << puntuacionTotal[j] << "\n";
+        cout << "==========================\n";
+    }
+
+    // Flujo principal del juego
+    void iniciar() {
+        cout << "===== BIENVENIDO A DOMINÓ (CONSOLE) =====\n";
+        configurarParticipantes();
+        jugarSesion();
+    }
+
+    // Retoma una partida guardada con la opción 6: los mismos nombres,
+    // como jugadores humanos, con sus puntajes y la ronda donde quedó
+    bool continuarDesde(const string& ruta) {
+        EstadoPartida e;
+        if (!e.cargar(ruta)) return false;
+        vector<Participante*> humanos;
+        for (int j = 0; j < e.totalJugadores; ++j) humanos.push_back(new ParticipanteHumano(e.nombres[j]));
+        configurarParticipantes(humanos);
+        if (!restaurarEstado(e)) return false;
+        cout << "===== PARTIDA RETOMADA DESDE " << ruta << " =====\n";
+        mostrarPuntajes();
+        jugarSesion();
+        return true;
+    }
+
+    // Rondas y menú de opciones hasta que se elija salir
+    void jugarSesion() {
+        bool salir = false;
+
+        while (!salir) {
+            if (rondaEnCurso) cout << "\n--> Continuando la ronda guardada...\n";
+            else cout << "\n--> Nueva ronda: barajando y repartiendo...\n";
+            int ganadorFinal = procesarPuntuacion(ejecutarRonda());
+            cout << "\nResumen de la ronda: ganador -> " << jugadores[ganadorFinal]->obtenerNombre() << "\n";
+            mostrarPuntajes();
+
+            // Opciones tras la ronda
+            cout << "\nOpciones:\n"
+                 << " 1 - Jugar otra ronda (mantener puntajes)\n"
+                 << " 2 - Reiniciar puntajes y empezar desde cero\n"
+                 << " 3 - Reiniciar jugadores y empezar con nueva configuración\n"
+                 << " 4 - Salir\n"
+                 << (TELEMETRIA_ACTIVA ? " 5 - Guardar telemetría en telemetria.json\n" : "")
+                 << " 6 - Guardar la partida en partida.dom (./juego --continuar partida.dom)\n"
+                 << "Elija una opción: ";
+            int opcion;
+            cin >> opcion;
+            if (cin.fail()) { cin.clear(); cin.ignore(numeric_limits<streamsize>::max(), '\n'); continue; }
+
+            if (opcion == 1) {
+                continue;
+            } else if (opcion == 2) {
+                for (int j = 0; j < totalJugadores; ++j) puntuacionTotal[j] = 0;
+                cout << "Puntajes reiniciados.\n";
+            } else if (opcion == 3) {
+                configurarParticipantes();
+            } else if (opcion == 4) {
+                salir = true;
+            } else if (opcion == 5 && TELEMETRIA_ACTIVA) {
+                ofstream archivo("telemetria.json");
+                archivo << telemetriaJSON();
+                cout << (archivo ? "Telemetría guardada en telemetria.json\n" : "No se pudo escribir telemetria.json\n");
+            } else if (opcion == 6) {
+                EstadoPartida e;
+                capturarEstado(e);
+                cout << (e.guardar("partida.dom") ? "Partida guardada en partida.dom\n" : "No se pudo escribir partida.dom\n");
+            } else {
+                cout << "Opción desconocida, continuando.\n";
+            }
+        }
+        cout << "Gracias por jugar. ¡Hasta la próxima!\n";
+    }
+}; // fin clase PartidaDomino
+
+// =========================
+// Clase SimuladorDomino
+// Motor sin consola con las mismas reglas que PartidaDomino:
+// 28 piezas barajadas, 7 por jugador, el resto al pozo (se roba del
+// final); empieza el jugador 0; quien no puede jugar roba hasta poder
+// o pasa si el pozo está vacío; gana quien se queda sin piezas y, si
+// todos pasan seguidos, quien tenga menos puntos (empates: el nombre
+// menor, como en procesarPuntuacion). El
+// ganador suma los puntos en mano de los demás.
+// Cada mano es una máscara de 28 bits y el pozo un arreglo fijo de
+// identificadores (su orden importa al robar); no se reserva memoria ni
+// se escribe en consola durante las rondas.
+// =========================
+struct ResultadoRonda {
+    int ganador = -1;       // Índice del ganador de la ronda
+    bool bloqueo = false;   // true si terminó porque nadie podía jugar
+    int puntos = 0;         // Puntos que obtuvo el ganador
+    int turnos = 0;         // Turnos jugados (incluye pases)
+};
+
+class SimuladorDomino {
+private:
+    vector<ParticipanteAutomatico*> jugadores;  // No se liberan aquí
+    int totalJugadores;
+    GeneradorRapido azar;
+    int rangoNombre[MAX_JUGADORES];   // Posición de cada nombre en orden alfabético
+
+    uint8_t pozo[TOTAL_PIEZAS];
+    int tamPozo = 0;
+    uint32_t manos[MAX_JUGADORES];
+    EstadoVisible estado;
+    EscritorRegistro* registro = nullptr;  // Registro binario opcional (no se libera aquí)
+
+    vector<long long> puntuacionTotal;
+    vector<long long> victorias;
+    long long rondasJugadas = 0;
+
+public:
+    // Constructor: recibe 2-4 jugadores automáticos y una semilla
+    SimuladorDomino(const vector<ParticipanteAutomatico*>& jugadores_, uint64_t semilla)
+        : jugadores(jugadores_), totalJugadores((int)jugadores_.size()), azar(semilla),
+          puntuacionTotal(jugadores_.size(), 0), victorias(jugadores_.size(), 0)
+    {
+        for (int i = 0; i < totalJugadores; ++i) {
+            rangoNombre[i] = 0;
+            for (int k = 0; k < totalJugadores; ++k)
+                if (jugadores[k]->obtenerNombre() < jugadores[i]->obtenerNombre()) rangoNombre[i]++;
+        }
+        estado.totalJugadores = totalJugadores;
+        estado.azar = &azar;
+    }
+
+    // Activa (o con nullptr desactiva) el registro binario de las rondas
+    void registrarEn(EscritorRegistro* escritor) { registro = escritor; }
+
+    // Juega una ronda completa y acumula la puntuación
+    ResultadoRonda jugarRonda() {
+        ResultadoRonda resultado;
+
+        // Barajar (Fisher-Yates) y repartir desde el final del pozo
+        for (int i = 0; i < TOTAL_PIEZAS; ++i) pozo[i] = (uint8_t)i;
+        for (int i = TOTAL_PIEZAS - 1; i > 0; --i)
+            swap(pozo[i], pozo[azar.menorQue((uint32_t)i + 1)]);
+        tamPozo = TOTAL_PIEZAS;
+        if (registro) registro->iniciarPartida(totalJugadores, pozo);
+        for (int j = 0; j < totalJugadores; ++j) {
+            manos[j] = 0;
+            estado.piezasJugadores[j] = 0;
+            estado.valoresAusentes[j] = 0;
+        }
+        for (int r = 0; r < PIEZAS_POR_MANO; ++r)
+            for (int j = 0; j < totalJugadores && tamPozo > 0; ++j) {
+                manos[j] |= 1u << pozo[--tamPozo];
+                estado.piezasJugadores[j]++;
+            }
+        estado.extremoIzq = estado.extremoDer = -1;
+        estado.enMesa = 0;
+
+        int turno = 0, pasesConsecutivos = 0;
+        Jugada legales[2 * TOTAL_PIEZAS];
+        while (true) {
+            ++resultado.turnos;
+            uint32_t& mano = manos[turno];
+            int pozoAntes = tamPozo;
+            // Robar: solo la pieza nueva puede cambiar la situación, y la
+            // comprobación de cada extremo es un AND con su máscara
+            while (!(jugablesEn(mano, estado.extremoIzq) | jugablesEn(mano, estado.extremoDer)) &&
+                   tamPozo > 0) {
+                mano |= 1u << pozo[--tamPozo];
+                estado.piezasJugadores[turno]++;
+                if (registro) registro->robo(pozo[tamPozo]);
+            }
+            // Lo que ven todos: quien roba no tenía esos valores y, como la
+            // única robada que encaja es la última (que juega), tampoco los
+            // conserva; lo sabido antes deja de valer porque robó piezas nuevas
+            uint8_t valoresExtremos = estado.extremoIzq < 0 ? 0
+                                    : (uint8_t)(1 << estado.extremoIzq | 1 << estado.extremoDer);
+            if (tamPozo != pozoAntes) estado.valoresAusentes[turno] = valoresExtremos;
+            int total = generarJugadas(mano, estado.extremoIzq, estado.extremoDer, legales);
+
+            if (total > 0) {
+                estado.mano = mano;
+                estado.piezasPozo = tamPozo;
+                estado.jugador = turno;
+                Jugada j = legales[jugadores[turno]->elegirJugada(estado, legales, total)];
+
+                int nuevo = extremoResultante(j, estado.extremoIzq, estado.extremoDer);
+                if (registro) {
+                    // Volteada: el lado izquierdo en mesa no es el menor de la pieza
+                    int izquierdoEnMesa = estado.extremoIzq < 0 ? tablaPiezas.izquierdo[j.pieza]
+                                        : j.lado == 0 ? nuevo : estado.extremoDer;
+                    registro->jugada(j.pieza, estado.extremoIzq < 0 ? 1 : j.lado,
+                                     izquierdoEnMesa != tablaPiezas.izquierdo[j.pieza]);
+                }
+                if (estado.extremoIzq < 0) {
+                    estado.extremoIzq = tablaPiezas.izquierdo[j.pieza];
+                    estado.extremoDer = tablaPiezas.derecho[j.pieza];
+                } else if (j.lado == 0) {
+                    estado.extremoIzq = nuevo;
+                } else {
+                    estado.extremoDer = nuevo;
+                }
+                estado.enMesa |= 1u << j.pieza;
+                mano &= ~(1u << j.pieza);
+                estado.piezasJugadores[turno]--;
+
+                pasesConsecutivos = 0;
+                if (estado.piezasJugadores[turno] == 0) {
+                    resultado.ganador = turno;
+                    break;
+                }
+            } else {
+                estado.valoresAusentes[turno] |= valoresExtremos;
+                if (registro) registro->pase();
+                if (++pasesConsecutivos >= totalJugadores) {
+                    resultado.bloqueo = true;
+                    break;
+                }
+            }
+            turno = turno + 1 == totalJugadores ? 0 : turno + 1;
+        }
+
+        if (registro) registro->finPartida(resultado.bloqueo);
+
+        // Puntuación: suma de puntos en mano de cada jugador
+        int sumas[MAX_JUGADORES];
+        for (int p = 0; p < totalJugadores; ++p) sumas[p] = puntosDe(manos[p]);
+        if (resultado.bloqueo) {
+            int ganador = 0;
+            for (int p = 1; p < totalJugadores; ++p)
+                if (sumas[p] < sumas[ganador] || (sumas[p] == sumas[ganador] && rangoNombre[p] < rangoNombre[ganador]))
+                    ganador = p;
+            resultado.ganador = ganador;
+        }
+        for (int p = 0; p < totalJugadores; ++p)
+            if (p != resultado.ganador) resultado.puntos += sumas[p];
+        puntuacionTotal[resultado.ganador] += resultado.puntos;
+        victorias[resultado.ganador]++;
+        rondasJugadas++;
+        return resultado;
+    }
+
+    // Juega una ronda cuyo azar (barajada y jugadores aleatorios) depende
+    // solo de la semilla: la misma semilla da exactamente la misma ronda
+    ResultadoRonda jugarRonda(uint64_t semilla) {
+        azar = GeneradorRapido(semilla);
+        return jugarRonda();
+    }
+
+    // Juega varias rondas seguidas
+    void jugarRondas(long long cantidad) {
+        for (long long i = 0; i < cantidad; ++i) jugarRonda();
+    }
+
+    // Puntos acumulados, rondas ganadas y rondas jugadas
+    const vector<long long>& obtenerPuntuacion() const { return puntuacionTotal; }
+    const vector<long long>& obtenerVictorias() const { return victorias; }
+    long long obtenerRondas() const { return rondasJugadas; }
+};
+
+// =========================
+// Torneo paralelo y reproducible
+// Cada partida i usa la semilla semillaPartida(maestra, i), así su
+// resultado no depende de qué hilo la juegue ni en qué orden. Los hilos
+// toman bloques de partidas con un contador atómico y acumulan en su
+// propia copia de las estadísticas (sin bloqueos); al final se suman.
+// Como son sumas de enteros, el total es idéntico con cualquier
+// cantidad de hilos.
+// =========================
+
+// Semilla de la partida 'indice' (mezcla splitmix64 de ambos valores)
+inline uint64_t semillaPartida(uint64_t maestra, uint64_t indice) {
+    GeneradorRapido mezcla(maestra ^ (indice * 0xD1B54A32D192ED03ULL));
+    return mezcla();
+}
+
+struct EstadisticasTorneo {
+    long long partidas = 0;
+    long long bloqueos = 0;
+    long long turnos = 0;
+    long long victorias[MAX_JUGADORES] = {0};
+    long long puntos[MAX_JUGADORES] = {0};
+    uint64_t huella = 0;  // Suma de una mezcla de cada resultado: cambia si cambia cualquier partida
+
+    // Acumula las estadísticas de otro hilo
+    void sumar(const EstadisticasTorneo& otra) {
+        partidas += otra.partidas;
+        bloqueos += otra.bloqueos;
+        turnos += otra.turnos;
+        for (int j = 0; j < MAX_JUGADORES; ++j) {
+            victorias[j] += otra.victorias[j];
+            puntos[j] += otra.puntos[j];
+        }
+        huella += otra.huella;
+    }
+};
+
+class TorneoDomino {
+private:
+    // Crea un juego de jugadores nuevo para cada hilo (se liberan al terminar)
+    function<vector<ParticipanteAutomatico*>()> fabricaJugadores;
+    uint64_t semillaMaestra;
+
+public:
+    // Partidas que un hilo toma de una vez del contador compartido
+    static const long long BLOQUE_PARTIDAS = 4096;
+
+    TorneoDomino(function<vector<ParticipanteAutomatico*>()> fabrica, uint64_t semilla)
+        : fabricaJugadores(move(fabrica)), semillaMaestra(semilla) {}
+
+    // Juega 'partidas' partidas con 'hilos' hilos (0: todos los núcleos)
+    EstadisticasTorneo jugar(long long partidas, unsigned hilos = 0) {
+        if (hilos == 0)
+            hilos = max(1u, thread::hardware_concurrency());
+
+        // Una entrada por hilo, cada una en su propia línea de caché
+        struct alignas(64) Parcial { EstadisticasTorneo datos; };
+        vector<Parcial> parciales(hilos);
+        atomic<long long> siguiente(0);
+
+        auto trabajar = [&](unsigned h) {
+            vector<ParticipanteAutomatico*> jugadores = fabricaJugadores();
+            SimuladorDomino simulador(jugadores, 0);
+            EstadisticasTorneo& e = parciales[h].datos;
+            while (true) {
+                long long inicio = siguiente.fetch_add(BLOQUE_PARTIDAS);
+                if (inicio >= partidas) break;
+                long long fin = min(partidas, inicio + BLOQUE_PARTIDAS);
+                for (long long i = inicio; i < fin; ++i) {
+                    ResultadoRonda r = simulador.jugarRonda(semillaPartida(semillaMaestra, (uint64_t)i));
+                    e.partidas++;
+                    e.bloqueos += r.bloqueo;
+                    e.turnos += r.turnos;
+                    e.victorias[r.ganador]++;
+                    e.puntos[r.ganador] += r.puntos;
+                    e.huella += semillaPartida((uint64_t)i, (uint64_t)(r.ganador * 1000 + r.puntos) * 1000 + r.turnos);
+                }
+            }
+            for (auto p : jugadores) delete p;
+        };
+
+        vector<thread> grupo;
+        for (unsigned h = 1; h < hilos; ++h)
+            grupo.emplace_back(trabajar, h);
+        trabajar(0);
+        for (auto& t : grupo)
+            t.join();
+
+        EstadisticasTorneo total;
+        for (const auto& p : parciales) total.sumar(p.datos);
+        return total;
+    }
+};
+
+// =========================
+// Servidor de mesas por red (solo Linux: epoll)
+// Un hilo con un bucle de eventos atiende miles de conexiones no
+// bloqueantes por TCP local o socket Unix. Cada conexión es una mesa que
+// un bot juega en todos los asientos; las reglas son las de
+// SimuladorDomino (EstadoSimulado) y cada turno llega como un mensaje en
+// vez de leerse con cin. Protocolo de líneas de texto:
+//   cliente:  N <jugadores> <semilla>        nueva mesa (2-4 jugadores)
+//             J <pieza> <lado>               jugar (pieza 0..27, lado 0 izq / 1 der)
+//             P                              pasar (solo si no hay jugada)
+//   servidor: T <asiento> <izq> <der> <mano> turno: extremos (-1: vacío) y
+//                                            mano en hexadecimal, ya robó lo necesario
+//             F <ganador> <puntos> <bloqueo> fin de la mesa
+//             E <motivo>                     mensaje rechazado
+// Una línea de más de MAX_LINEA_SERVIDOR bytes, o un cliente que deja
+// acumular más de MAX_SALIDA_SERVIDOR bytes sin leerlos, cierra la conexión.
+// =========================
+#if defined(__linux__)
+
+const size_t MAX_LINEA_SERVIDOR = 256;        // Una línea válida ocupa unos 20 bytes
+const size_t MAX_SALIDA_SERVIDOR = 64 * 1024;  // Respuestas pendientes por conexión
+const int PAUSA_ESCUCHA_MS = 100;             // Espera tras quedarse sin descriptores
+
+// Lee un entero decimal y avanza 'p'; false si no hay dígitos
+inline bool leerEntero(const char*& p, long& valor) {
+    char* fin;
+    valor = strtol(p, &fin, 10);
+    if (fin == p) return false;
+    p = fin;
+    return true;
+}
+
+// Solo quedan espacios (o el '\r' de un cliente que envía CRLF)
+inline bool finDeLinea(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r') ++p;
+    return *p == '\0';
+}
+
+// Pone un descriptor en modo no bloqueante
+inline bool sinBloqueo(int descriptor) {
+    int banderas = fcntl(descriptor, F_GETFL, 0);
+    return banderas >= 0 && fcntl(descriptor, F_SETFL, banderas | O_NONBLOCK) == 0;
+}
+
+// Sube el límite de descriptores abiertos al máximo permitido
+inline void ampliarLimiteDescriptores() {
+    struct rlimit limite;
+    if (getrlimit(RLIMIT_NOFILE, &limite) == 0 && limite.rlim_cur < limite.rlim_max) {
+        limite.rlim_cur = limite.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limite);
+    }
+}
+
+// Destino "12345" = puerto TCP en 127.0.0.1; cualquier otro texto = ruta de socket Unix
+inline bool esPuerto(const string& destino) {
+    return !destino.empty() && all_of(destino.begin(), destino.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+
+// Conecta (bloqueante) al destino y deja el socket no bloqueante; -1 si falla
+inline int conectarDestino(const string& destino) {
+    int descriptor;
+    if (esPuerto(destino)) {
+        descriptor = socket(AF_INET, SOCK_STREAM, 0);
+        if (descriptor < 0) return -1;
+        sockaddr_in direccion{};
+        direccion.sin_family = AF_INET;
+        direccion.sin_port = htons((uint16_t)stoi(destino));
+        direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (connect(descriptor, (sockaddr*)&direccion, sizeof(direccion)) != 0) { close(descriptor); return -1; }
+        int uno = 1;
+        setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+    } else {
+        descriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (descriptor < 0) return -1;
+        sockaddr_un direccion{};
+        direccion.sun_family = AF_UNIX;
+        if (destino.size() >= sizeof(direccion.sun_path)) { close(descriptor); return -1; }
+        memcpy(direccion.sun_path, destino.c_str(), destino.size() + 1);
+        if (connect(descriptor, (sockaddr*)&direccion, sizeof(direccion)) != 0) { close(descriptor); return -1; }
+    }
+    sinBloqueo(descriptor);
+    return descriptor;
+}
+
+// Búfer de salida de una conexión: lo que no entra en el socket espera
+// a que epoll avise que se puede escribir
+struct SalidaPendiente {
+    string datos;
+    size_t enviado = 0;
+
+    // Intenta enviar todo; false si la conexión se cerró
+    bool enviar(int descriptor) {
+        while (enviado < datos.size()) {
+            ssize_t n = send(descriptor, datos.data() + enviado, datos.size() - enviado, MSG_NOSIGNAL);
+            if (n > 0) { enviado += (size_t)n; continue; }
+            if (n < 0 && errno == EINTR) continue;
+            return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+        }
+        datos.clear();
+        enviado = 0;
+        return true;
+    }
+    bool vacia() const { return datos.empty(); }
+};
+
+class ServidorDomino {
+private:
+    struct Conexion {
+        int descriptor = -1;
+        string entrada;
+        SalidaPendiente salida;
+        bool esperaEscritura = false;  // Registrada para EPOLLOUT
+        bool enJuego = false;
+        EstadoSimulado mesa;
+        uint64_t legales = 0;          // Códigos legales del turno actual
+    };
+
+    int escucha = -1;
+    int epoll = -1;
+    string rutaUnix;
+    uint16_t puerto = 0;
+    vector<unique_ptr<Conexion>> conexiones;  // Indexadas por descriptor
+    atomic<bool> detenido{false};
+    bool escuchaPausada = false;              // Sin descriptores: se deja de vigilar la escucha
+    chrono::steady_clock::time_point reanudarEscucha;
+    int abiertas = 0;
+    long long jugadas = 0;
+    long long mesasTerminadas = 0;
+
+    bool prepararEscucha() {
+        if (listen(escucha, SOMAXCONN) != 0 || !sinBloqueo(escucha)) return false;
+        epoll = epoll_create1(0);
+        if (epoll < 0) return false;
+        epoll_event evento{};
+        evento.events = EPOLLIN;
+        evento.data.fd = escucha;
+        return epoll_ctl(epoll, EPOLL_CTL_ADD, escucha, &evento) == 0;
+    }
+
+    void cerrarConexion(Conexion& c) {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, c.descriptor, nullptr);
+        close(c.descriptor);
+        conexiones[c.descriptor].reset();
+        --abiertas;
+    }
+
+    // Con epoll por nivel, una escucha con conexiones pendientes que no se
+    // pueden aceptar (EMFILE) despertaría el bucle sin pausa: se quita del
+    // epoll y se vuelve a registrar pasado PAUSA_ESCUCHA_MS
+    void pausarEscucha() {
+        epoll_ctl(epoll, EPOLL_CTL_DEL, escucha, nullptr);
+        escuchaPausada = true;
+        reanudarEscucha = chrono::steady_clock::now() + chrono::milliseconds(PAUSA_ESCUCHA_MS);
+    }
+
+    void reanudarSiToca() {
+        if (!escuchaPausada || chrono::steady_clock::now() < reanudarEscucha) return;
+        epoll_event evento{};
+        evento.events = EPOLLIN;
+        evento.data.fd = escucha;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, escucha, &evento);
+        escuchaPausada = false;
+    }
+
+    void aceptar() {
+        while (true) {
+            int descriptor = accept4(escucha, nullptr, nullptr, SOCK_NONBLOCK);
+            if (descriptor < 0) {
+                if (errno == EINTR || errno == ECONNABORTED) continue;
+                if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) pausarEscucha();
+                return;  // EAGAIN: no hay más pendientes
+            }
+            if (rutaUnix.empty()) {
+                int uno = 1;
+                setsockopt(descriptor, IPPROTO_TCP, TCP_NODELAY, &uno, sizeof(uno));
+            }
+            if ((size_t)descriptor >= conexiones.size()) conexiones.resize((size_t)descriptor + 1);
+            conexiones[descriptor].reset(new Conexion());
+            conexiones[descriptor]->descriptor = descriptor;
+            epoll_event evento{};
+            evento.events = EPOLLIN;
+            evento.data.fd = descriptor;
+            epoll_ctl(epoll, EPOLL_CTL_ADD, descriptor, &evento);
+            ++abiertas;
+        }
+    }
+
+    // Roba lo necesario para el jugador de turno y le envía su situación
+    void anunciarTurno(Conexion& c) {
+        uint8_t codigos[2 * TOTAL_PIEZAS];
+        int n = c.mesa.prepararTurno(codigos);
+        c.legales = 0;
+        for (int i = 0; i < n; ++i) c.legales |= 1ULL << codigos[i];
+        char linea[64];
+        int largo = snprintf(linea, sizeof(linea), "T %d %d %d %x\n", c.mesa.turno, c.mesa.extremoIzq,
+                             c.mesa.extremoDer, c.mesa.manos[c.mesa.turno]);
+        c.salida.datos.append(linea, (size_t)largo);
+    }
+
+    // Aplica una jugada validada y responde con el siguiente turno o el fin
+    void aplicarJugada(Conexion& c, uint8_t codigo) {
+        c.mesa.aplicar(codigo);
+        ++jugadas;
+        if (c.mesa.ganador < 0) {
+            anunciarTurno(c);
+            return;
+        }
+        int puntos = 0;
+        for (int p = 0; p < c.mesa.totalJugadores; ++p)
+            if (p != c.mesa.ganador) puntos += puntosDe(c.mesa.manos[p]);
+        char linea[48];
+        int largo = snprintf(linea, sizeof(linea), "F %d %d %d\n", c.mesa.ganador, puntos,
+                             c.mesa.pasesConsecutivos >= c.mesa.totalJugadores ? 1 : 0);
+        c.salida.datos.append(linea, (size_t)largo);
+        c.enJuego = false;
+        ++mesasTerminadas;
+    }
+
+    void procesarLinea(Conexion& c, const char* linea) {
+        const char* p = linea + 1;
+        if (linea[0] == 'N') {
+            long jugadores;
+            char* fin;
+            if (!leerEntero(p, jugadores)) {
+                c.salida.datos += "E formato\n";
+                return;
+            }
+            unsigned long long semilla = strtoull(p, &fin, 10);
+            if (fin == p || !finDeLinea(fin)) {
+                c.salida.datos += "E formato\n";
+                return;
+            }
+            if (jugadores < 2 || jugadores > MAX_JUGADORES) {
+                c.salida.datos += "E jugadores\n";
+                return;
+            }
+            GeneradorRapido azar(semilla);
+            c.mesa.repartir((int)jugadores, azar);
+            c.enJuego = true;
+            anunciarTurno(c);
+        } else if (!c.enJuego) {
+            c.salida.datos += "E sin mesa\n";
+        } else if (linea[0] == 'J') {
+            long pieza, lado;
+            if (!leerEntero(p, pieza) || !leerEntero(p, lado) || !finDeLinea(p)) {
+                c.salida.datos += "E formato\n";
+                return;
+            }
+            // Con ambos extremos iguales los dos lados son la misma jugada
+            if (c.mesa.extremoIzq >= 0 && c.mesa.extremoIzq == c.mesa.extremoDer) lado = 1;
+            if (pieza < 0 || pieza >= TOTAL_PIEZAS || (lado != 0 && lado != 1) ||
+                !(c.legales >> (pieza | lado << 5) & 1)) {
+                c.salida.datos += "E jugada ilegal\n";
+                return;
+            }
+            aplicarJugada(c, (uint8_t)(pieza | lado << 5));
+        } else if (linea[0] == 'P') {
+            if (!finDeLinea(p)) {
+                c.salida.datos += "E formato\n";
+                return;
+            }
+            if (c.legales != 1ULL << EstadoSimulado::PASE) {
+                c.salida.datos += "E tiene jugada\n";
+                return;
+            }
+            aplicarJugada(c, EstadoSimulado::PASE);
+        } else {
+            c.salida.datos += "E mensaje desconocido\n";
+        }
+    }
+
+    // Atiende las líneas completas de la entrada y envía lo que se pueda;
+    // false si la conexión se cerró o abusa (línea sin terminar demasiado
+    // larga o respuestas que no lee)
+    bool procesarEntrada(Conexion& c) {
+        size_t inicio = 0, salto;
+        while ((salto = c.entrada.find('\n', inicio)) != string::npos) {
+            c.entrada[salto] = '\0';
+            procesarLinea(c, c.entrada.c_str() + inicio);
+            inicio = salto + 1;
+        }
+        c.entrada.erase(0, inicio);
+        if (!c.salida.enviar(c.descriptor)) return false;
+        return c.entrada.size() <= MAX_LINEA_SERVIDOR && c.salida.datos.size() <= MAX_SALIDA_SERVIDOR;
+    }
+
+    // Lee lo disponible, atiende las líneas completas y responde
+    void atender(Conexion& c, uint32_t eventos) {
+        if (eventos & EPOLLIN) {
+            char bloque[4096];
+            while (true) {
+                ssize_t n = recv(c.descriptor, bloque, sizeof(bloque), 0);
+                if (n > 0) {
+                    // Se procesa cada bloque para que la entrada no crezca sin límite
+                    c.entrada.append(bloque, (size_t)n);
+                    if (!procesarEntrada(c)) {
+                        cerrarConexion(c);
+                        return;
+                    }
+                    continue;
+                }
+                if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                    cerrarConexion(c);
+                    return;
+                }
+                if (errno != EINTR) break;
+            }
+        }
+        if (!c.salida.enviar(c.descriptor)) {
+            cerrarConexion(c);
+            return;
+        }
+        // Solo se pide EPOLLOUT mientras quede algo por enviar
+        bool pendiente = !c.salida.vacia();
+        if (pendiente != c.esperaEscritura) {
+            epoll_event evento{};
+            evento.events = EPOLLIN | (pendiente ? (uint32_t)EPOLLOUT : 0u);
+            evento.data.fd = c.descriptor;
+            epoll_ctl(epoll, EPOLL_CTL_MOD, c.descriptor, &evento);
+            c.esperaEscritura = pendiente;
+        }
+    }
+
+public:
+    ServidorDomino() { ampliarLimiteDescriptores(); }
+
+    ~ServidorDomino() {
+        for (auto& c : conexiones)
+            if (c) close(c->descriptor);
+        if (escucha >= 0) close(escucha);
+        if (epoll >= 0) close(epoll);
+        if (!rutaUnix.empty()) unlink(rutaUnix.c_str());
+    }
+
+    ServidorDomino(const ServidorDomino&) = delete;
+    ServidorDomino& operator=(const ServidorDomino&) = delete;
+
+    // Escucha en 127.0.0.1 (puerto 0: el sistema elige uno libre)
+    bool escucharTcp(uint16_t puerto_) {
+        escucha = socket(AF_INET, SOCK_STREAM, 0);
+        if (escucha < 0) return false;
+        int uno = 1;
+        setsockopt(escucha, SOL_SOCKET, SO_REUSEADDR, &uno, sizeof(uno));
+        sockaddr_in direccion{};
+        direccion.sin_family = AF_INET;
+        direccion.sin_port = htons(puerto_);
+        direccion.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(escucha, (sockaddr*)&direccion, sizeof(direccion)) != 0) return false;
+        socklen_t largo = sizeof(direccion);
+        getsockname(escucha, (sockaddr*)&direccion, &largo);
+        puerto = ntohs(direccion.sin_port);
+        return prepararEscucha();
+    }
+
+    // Escucha en un socket Unix (reemplaza un archivo viejo con esa ruta)
+    bool escucharUnix(const string& ruta) {
+        escucha = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (escucha < 0) return false;
+        sockaddr_un direccion{};
+        direccion.sun_family = AF_UNIX;
+        if (ruta.size() >= sizeof(direccion.sun_path)) return false;
+        memcpy(direccion.sun_path, ruta.c_str(), ruta.size() + 1);
+        unlink(ruta.c_str());
+        if (bind(escucha, (sockaddr*)&direccion, sizeof(direccion)) != 0) return false;
+        rutaUnix = ruta;
+        return prepararEscucha();
+    }
+
+    // Acepta "12345" (puerto TCP) o una ruta de socket Unix
+    bool escuchar(const string& destino) {
+        return esPuerto(destino) ? escucharTcp((uint16_t)stoi(destino)) : escucharUnix(destino);
+    }
+
+    // Bucle de eventos; vuelve cuando se llama a detener() (desde otro hilo o una señal)
+    void ejecutar() {
+        epoll_event eventos[256];
+        while (!detenido.load(memory_order_relaxed)) {
+            int n = epoll_wait(epoll, eventos, 256, escuchaPausada ? PAUSA_ESCUCHA_MS : 100);
+            reanudarSiToca();
+            for (int i = 0; i < n; ++i) {
+                int descriptor = eventos[i].data.fd;
+                if (descriptor == escucha) aceptar();
+                else if ((size_t)descriptor < conexiones.size() && conexiones[descriptor])
+                    atender(*conexiones[descriptor], eventos[i].events);
+            }
+        }
+    }
+
+    void detener() { detenido.store(true); }
+
+    uint16_t obtenerPuerto() const { return puerto; }
+    int conexionesAbiertas() const { return abiertas; }
+    long long obtenerJugadas() const { return jugadas; }
+    long long obtenerMesasTerminadas() const { return mesasTerminadas; }
+};
+
+// =========================
+// Generador de carga: muchas conexiones, cada una juega mesas seguidas
+// con un bot codicioso y mide cuánto tarda la respuesta a cada jugada
+// =========================
+struct ResultadoCarga {
+    int conexiones = 0;
+    long long jugadas = 0;
+    long long mesas = 0;
+    long long errores = 0;
+    double segundos = 0;
+    double p50 = 0, p99 = 0;  // Latencia por jugada en microsegundos
+};
+
+ResultadoCarga generarCarga(const string& destino, int conexiones, double segundos, int jugadoresPorMesa) {
+    ResultadoCarga resultado;
+    ampliarLimiteDescriptores();
+    struct Bot {
+        int descriptor = -1;
+        string entrada;
+        SalidaPendiente salida;
+        uint64_t semilla = 0;
+        chrono::steady_clock::time_point envio;
+        bool esperaJugada = false;  // Envió una jugada y espera la respuesta
+    };
+    vector<Bot> bots(conexiones);
+    int epoll = epoll_create1(0);
+    for (int i = 0; i < conexiones; ++i) {
+        bots[i].descriptor = conectarDestino(destino);
+        if (bots[i].descriptor < 0) break;
+        bots[i].semilla = (uint64_t)i << 32;
+        epoll_event evento{};
+        evento.events = EPOLLIN;
+        evento.data.u32 = (uint32_t)i;
+        epoll_ctl(epoll, EPOLL_CTL_ADD, bots[i].descriptor, &evento);
+        resultado.conexiones++;
+    }
+
+    vector<uint32_t> latencias;  // Nanosegundos
+    latencias.reserve(1 << 22);
+    char linea[64];
+    auto nuevaMesa = [&](Bot& b) {
+        int largo = snprintf(linea, sizeof(linea), "N %d %llu\n", jugadoresPorMesa, (unsigned long long)b.semilla++);
+        b.salida.datos.append(linea, (size_t)largo);
+    };
+    for (int i = 0; i < resultado.conexiones; ++i) {
+        nuevaMesa(bots[i]);
+        bots[i].salida.enviar(bots[i].descriptor);
+    }
+
+    auto inicio = chrono::steady_clock::now();
+    auto limite = inicio + chrono::microseconds((long long)(segundos * 1e6));
+    epoll_event eventos[256];
+    while (chrono::steady_clock::now() < limite) {
+        int n = epoll_wait(epoll, eventos, 256, 10);
+        auto ahora = chrono::steady_clock::now();
+        for (int e = 0; e < n; ++e) {
+            Bot& b = bots[eventos[e].data.u32];
+            char bloque[4096];
+            ssize_t leidos;
+            while ((leidos = recv(b.descriptor, bloque, sizeof(bloque), 0)) > 0) b.entrada.append(bloque, (size_t)leidos);
+            if (leidos == 0) {
+                // El servidor cerró esta conexión
+                epoll_ctl(epoll, EPOLL_CTL_DEL, b.descriptor, nullptr);
+                close(b.descriptor);
+                b.descriptor = -1;
+                resultado.errores++;
+                continue;
+            }
+            size_t inicioLinea = 0, salto;
+            while ((salto = b.entrada.find('\n', inicioLinea)) != string::npos) {
+                const char* l = b.entrada.c_str() + inicioLinea;
+                if (b.esperaJugada) {
+                    latencias.push_back((uint32_t)min<long long>(UINT32_MAX,
+                        chrono::duration_cast<chrono::nanoseconds>(ahora - b.envio).count()));
+                    b.esperaJugada = false;
+                }
+                if (l[0] == 'T') {
+                    // Bot codicioso: la jugada legal de más puntos
+                    char* fin;
+                    strtol(l + 1, &fin, 10);
+                    int izq = (int)strtol(fin, &fin, 10), der = (int)strtol(fin, &fin, 10);
+                    uint32_t mano = (uint32_t)strtoul(fin, &fin, 16);
+                    Jugada legales[2 * TOTAL_PIEZAS];
+                    int total = generarJugadas(mano, izq, der, legales);
+                    int largo;
+                    if (total == 0) {
+                        largo = snprintf(linea, sizeof(linea), "P\n");
+                    } else {
+                        int mejor = 0;
+                        for (int i = 1; i < total; ++i)
+                            if (tablaPiezas.puntos[legales[i].pieza] > tablaPiezas.puntos[legales[mejor].pieza]) mejor = i;
+                        largo = snprintf(linea, sizeof(linea), "J %d %d\n", legales[mejor].pieza, legales[mejor].lado);
+                    }
+                    b.salida.datos.append(linea, (size_t)largo);
+                    b.envio = chrono::steady_clock::now();
+                    b.esperaJugada = true;
+                    resultado.jugadas++;
+                } else if (l[0] == 'F') {
+                    resultado.mesas++;
+                    nuevaMesa(b);
+                } else {
+                    // Mensaje rechazado: el bot abandona la mesa y empieza otra
+                    // para no quedarse esperando un turno que no llegará
+                    resultado.errores++;
+                    nuevaMesa(b);
+                }
+                inicioLinea = salto + 1;
+            }
+            b.entrada.erase(0, inicioLinea);
+            b.salida.enviar(b.descriptor);
+        }
+    }
+    resultado.segundos = chrono::duration<double>(chrono::steady_clock::now() - inicio).count();
+
+    for (auto& b : bots)
+        if (b.descriptor >= 0) close(b.descriptor);
+    close(epoll);
+    if (!latencias.empty()) {
+        size_t i50 = latencias.size() / 2, i99 = latencias.size() * 99 / 100;
+        nth_element(latencias.begin(), latencias.begin() + i50, latencias.end());
+        resultado.p50 = latencias[i50] / 1000.0;
+        nth_element(latencias.begin(), latencias.begin() + i99, latencias.end());
+        resultado.p99 = latencias[i99] / 1000.0;
+    }
+    return resultado;
+}
+
+// Imprime un resultado de carga en una línea
+void mostrarCarga(const string& titulo, const ResultadoCarga& r) {
+    cout << titulo << ": " << r.conexiones << " mesas simultáneas, " << fixed << setprecision(0)
+         << r.jugadas / r.segundos << " jugadas/s, " << r.mesas / r.segundos << " mesas terminadas/s, latencia p50 "
+         << setprecision(1) << r.p50 << " us, p99 " << r.p99 << " us, " << r.errores << " errores\n";
+}
+
+#endif
+
+// =========================
+// Benchmark del torneo: mismas estadísticas con 1, 2, 4 y 8 hilos
+// =========================
+void benchTorneo() {
+    cout << "=== BENCH torneo paralelo ===\n";
+    cout << "hilos disponibles: " << thread::hardware_concurrency() << "\n";
+    const long long PARTIDAS = 4000000;
+    TorneoDomino torneo([] {
+        return vector<ParticipanteAutomatico*>{new ParticipanteHeuristico("Heuristico"),
+                                               new ParticipanteCodicioso("Codicioso"),
+                                               new ParticipanteAleatorio("Aleatorio")};
+    }, 2024);
+
+    EstadisticasTorneo referencia;
+    for (unsigned hilos : {1u, 2u, 4u, 8u}) {
+        auto t0 = chrono::steady_clock::now();
+        EstadisticasTorneo e = torneo.jugar(PARTIDAS, hilos);
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        if (hilos == 1) referencia = e;
+        bool iguales = e.huella == referencia.huella && e.partidas == referencia.partidas &&
+                       equal(e.victorias, e.victorias + MAX_JUGADORES, referencia.victorias) &&
+                       equal(e.puntos, e.puntos + MAX_JUGADORES, referencia.puntos);
+        cout << setw(2) << hilos << " hilos: " << fixed << setprecision(0) << PARTIDAS / segundos
+             << " partidas/s, victorias " << e.victorias[0] << " / " << e.victorias[1] << " / "
+             << e.victorias[2] << ", huella " << hex << e.huella << dec << ", "
+             << (iguales ? "idéntico a 1 hilo" : "DISTINTO de 1 hilo") << "\n";
+    }
+}
+
+// =========================
+// Benchmark del simulador (./juego --bench)
+// =========================
+void benchSimulador() {
+    cout << "=== BENCH simulador sin consola ===\n";
+    const long long RONDAS = 2000000;
+
+    struct Mesa { const char* nombre; vector<ParticipanteAutomatico*> jugadores; };
+    vector<Mesa> mesas;
+    mesas.push_back({"4 aleatorios", {new ParticipanteAleatorio("A1"), new ParticipanteAleatorio("A2"),
+                                      new ParticipanteAleatorio("A3"), new ParticipanteAleatorio("A4")}});
+    mesas.push_back({"2 codiciosos", {new ParticipanteCodicioso("C1"), new ParticipanteCodicioso("C2")}});
+    mesas.push_back({"aleatorio, codicioso, heurístico",
+                     {new ParticipanteAleatorio("Aleatorio"), new ParticipanteCodicioso("Codicioso"),
+                      new ParticipanteHeuristico("Heuristico")}});
+    mesas.push_back({"heurístico vs codicioso", {new ParticipanteHeuristico("Heuristico"),
+                                                 new ParticipanteCodicioso("Codicioso")}});
+
+    for (auto& mesa : mesas) {
+        SimuladorDomino simulador(mesa.jugadores, 12345);
+        long long turnos = 0, bloqueos = 0;
+        auto t0 = chrono::steady_clock::now();
+        for (long long r = 0; r < RONDAS; ++r) {
+            ResultadoRonda resultado = simulador.jugarRonda();
+            turnos += resultado.turnos;
+            bloqueos += resultado.bloqueo;
+        }
+        double segundos = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+        cout << mesa.nombre << ": " << fixed << setprecision(0) << RONDAS / segundos
+             << " rondas/s (" << setprecision(1) << (double)turnos / RONDAS << " turnos por ronda, "
+             << 100.0 * bloqueos / RONDAS << "% bloqueos)\n   victorias:";
+        for (size_t i = 0; i < mesa.jugadores.size(); ++i)
+            cout << " " << mesa.jugadores[i]->obtenerNombre() << " "
+                 << 100.0 * simulador.obtenerVictorias()[i] / RONDAS << "%";
+        cout << "\n";
+        for (auto p : mesa.jugadores) delete p;
+    }
+}
+
+// =========================
+// Benchmark del registro binario: escribir, mapear y reproducir
+// =========================
+void benchRegistro() {
+    cout << "=== BENCH registro binario de partidas ===\n";
+    const long long RONDAS = 1000000;
+    const string ruta = "bench_registro.dlog";
+    vector<ParticipanteAutomatico*> jugadores{new ParticipanteHeuristico("Heuristico"),
+                                              new ParticipanteCodicioso("Codicioso"),
+                                              new ParticipanteAleatorio("Aleatorio")};
+
+    // Misma semilla con y sin registro: las rondas son idénticas
+    SimuladorDomino sinRegistro(jugadores, 777);
+    auto t0 = chrono::steady_clock::now();
+    sinRegistro.jugarRondas(RONDAS);
+    double segundosSin = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    vector<int> puntos(RONDAS), turnos(RONDAS);
+    long long movimientos = 0, bytes = 0;
+    double segundosCon;
+    {
+        EscritorRegistro escritor(ruta);
+        if (!escritor.valido()) { cout << "No se pudo crear " << ruta << "\n"; return; }
+        SimuladorDomino simulador(jugadores, 777);
+        simulador.registrarEn(&escritor);
+        t0 = chrono::steady_clock::now();
+        for (long long r = 0; r < RONDAS; ++r) {
+            ResultadoRonda resultado = simulador.jugarRonda();
+            puntos[r] = resultado.puntos;
+            turnos[r] = resultado.turnos;
+        }
+        escritor.cerrar();
+        segundosCon = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        movimientos = escritor.obtenerMovimientos();
+        bytes = escritor.obtenerBytes();
+    }
+    cout << "simulación sin registro: " << fixed << setprecision(0) << RONDAS / segundosSin
+         << " rondas/s; con registro: " << RONDAS / segundosCon << " rondas/s\n";
+    cout << "registro: " << setprecision(1) << bytes / 1048576.0 << " MB, "
+         << (double)bytes / RONDAS << " bytes por partida, " << (double)movimientos / RONDAS
+         << " movimientos por partida (1 byte cada uno)\n";
+
+    t0 = chrono::steady_clock::now();
+    LectorRegistro lector(ruta);
+    double segundosIndice = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    if (!lector.valido() || (long long)lector.totalPartidas() != RONDAS) {
+        cout << "Registro inválido\n";
+        remove(ruta.c_str());
+        return;
+    }
+
+    // Reproducción completa: cada partida debe terminar con los mismos
+    // puntos y turnos que dio el simulador
+    ReproductorPartida reproductor;
+    long long reproducidos = 0, discrepancias = 0;
+    t0 = chrono::steady_clock::now();
+    for (size_t i = 0; i < lector.totalPartidas(); ++i) {
+        reproductor.cargar(lector.datosPartida(i), lector.tamanoPartida(i));
+        bool ok = reproductor.reproducirTodo();
+        reproducidos += reproductor.movimientoActual();
+        int turnosJugados = 0;
+        for (size_t b = TAM_INICIO_PARTIDA; b + 1 < lector.tamanoPartida(i); ++b)
+            turnosJugados += (lector.datosPartida(i)[b] & 0xE0) != EVENTO_ROBO;
+        if (!ok || reproductor.puntosGanador() != puntos[i] || turnosJugados != turnos[i]) ++discrepancias;
+    }
+    double segundosRepro = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    cout << "índice de " << lector.totalPartidas() << " partidas: " << setprecision(1)
+         << segundosIndice * 1000 << " ms\n";
+    cout << "reproducción: " << setprecision(0) << reproducidos / segundosRepro << " movimientos/s, "
+         << discrepancias << " partidas distintas de la simulación\n";
+
+    // Acceso aleatorio: estado tras un movimiento cualquiera de una partida cualquiera
+    const int CONSULTAS = 1000000;
+    GeneradorRapido azar(99);
+    long long control = 0;
+    t0 = chrono::steady_clock::now();
+    for (int q = 0; q < CONSULTAS; ++q) {
+        size_t i = azar.menorQue((uint32_t)lector.totalPartidas());
+        reproductor.cargar(lector.datosPartida(i), lector.tamanoPartida(i));
+        reproductor.irA(azar.menorQue((uint32_t)lector.tamanoPartida(i) - (uint32_t)TAM_INICIO_PARTIDA));
+        control += reproductor.piezasEnMesa() + reproductor.manoDe(0);
+    }
+    double segundosConsultas = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    cout << "estados intermedios al azar: " << CONSULTAS / segundosConsultas << " consultas/s (control "
+         << control % 1000 << ")\n";
+
+    remove(ruta.c_str());
+    for (auto p : jugadores) delete p;
+}
+
+// =========================
+// Benchmark del solucionador del final
+// Las posiciones salen de partidas registradas de dos jugadores: el
+// momento en que el pozo queda vacío.
+// =========================
+
+// Minimax sin poda ni tabla, para comprobar los valores en finales chicos
+int minimaxIngenuo(uint32_t* manos, int turno, int izq, int der, bool pase, bool ganaEmpate0) {
+    Jugada legales[2 * TOTAL_PIEZAS];
+    int total = generarJugadas(manos[turno], izq, der, legales);
+    if (total == 0) {
+        if (pase) {
+            int propios = puntosDe(manos[turno]), ajenos = puntosDe(manos[turno ^ 1]);
+            bool gana = propios < ajenos || (propios == ajenos && ganaEmpate0 == (turno == 0));
+            return gana ? ajenos : -propios;
+        }
+        return -minimaxIngenuo(manos, turno ^ 1, izq, der, true, ganaEmpate0);
+    }
+    int mejor = INT_MIN;
+    for (int i = 0; i < total; ++i) {
+        const Jugada& j = legales[i];
+        uint32_t mano = manos[turno], bit = 1u << j.pieza;
+        int valor;
+        if (mano == bit) {
+            valor = puntosDe(manos[turno ^ 1]);
+        } else {
+            int nuevo = extremoResultante(j, izq, der);
+            int ni = izq < 0 ? tablaPiezas.izquierdo[j.pieza] : j.lado == 0 ? nuevo : izq;
+            int nd = izq < 0 ? tablaPiezas.derecho[j.pieza] : j.lado == 0 ? der : nuevo;
+            manos[turno] = mano & ~bit;
+            valor = -minimaxIngenuo(manos, turno ^ 1, ni, nd, false, ganaEmpate0);
+            manos[turno] = mano;
+        }
+        mejor = max(mejor, valor);
+    }
+    return mejor;
+}
+
+void benchFinal() {
+    cout << "=== BENCH solucionador del final (alfa-beta + tabla Zobrist) ===\n";
+    struct Posicion { uint32_t turno, rival; int izq, der; };
+    vector<Posicion> posiciones;
+    {
+        const string ruta = "bench_final.dlog";
+        {
+            EscritorRegistro escritor(ruta);
+            vector<ParticipanteAutomatico*> jugadores{new ParticipanteHeuristico("H1"),
+                                                      new ParticipanteAleatorio("A2")};
+            SimuladorDomino simulador(jugadores, 31337);
+            simulador.registrarEn(&escritor);
+            simulador.jugarRondas(4000);
+            for (auto p : jugadores) delete p;
+        }
+        LectorRegistro lector(ruta);
+        ReproductorPartida reproductor;
+        for (size_t i = 0; i < lector.totalPartidas(); ++i) {
+            reproductor.cargar(lector.datosPartida(i), lector.tamanoPartida(i));
+            while (reproductor.piezasEnPozo() > 0 && reproductor.avanzar()) {}
+            if (reproductor.piezasEnPozo() > 0 || reproductor.partidaTerminada()) continue;
+            int t = reproductor.jugadorDeTurno();
+            posiciones.push_back({reproductor.manoDe(t), reproductor.manoDe(t ^ 1),
+                                  reproductor.extremoIzq(), reproductor.extremoDer()});
+        }
+        remove(ruta.c_str());
+    }
+    cout << posiciones.size() << " posiciones con el pozo recién vaciado\n";
+
+    // Exactitud: mismo valor que el minimax completo en las posiciones chicas
+    SolucionadorFinal solucionador(16u << 20);
+    int comparadas = 0, distintas = 0;
+    for (const auto& p : posiciones) {
+        if (contarBits(p.turno | p.rival) > 12 || comparadas >= 300) continue;
+        uint32_t manos[2] = {p.turno, p.rival};
+        solucionador.limpiarTabla();
+        distintas += solucionador.resolver(p.turno, p.rival, p.izq, p.der, false, nullptr) !=
+                     minimaxIngenuo(manos, 0, p.izq, p.der, false, false);
+        ++comparadas;
+    }
+    cout << "contra minimax sin poda: " << comparadas << " posiciones, " << distintas << " valores distintos\n";
+
+    // Por tamaño del final (tabla vaciada antes de cada posición)
+    cout << "piezas en manos | posiciones | nodos promedio | nodos/s | aciertos en tabla\n";
+    const int GRUPOS[][2] = {{0, 12}, {13, 16}, {17, 20}, {21, 28}};
+    for (const auto& g : GRUPOS) {
+        long long cantidad = 0;
+        solucionador.reiniciarEstadisticas();
+        double segundos = 0;
+        for (const auto& p : posiciones) {
+            int n = contarBits(p.turno | p.rival);
+            if (n < g[0] || n > g[1]) continue;
+            solucionador.limpiarTabla();
+            auto t0 = chrono::steady_clock::now();
+            solucionador.resolver(p.turno, p.rival, p.izq, p.der, false, nullptr);
+            segundos += chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+            ++cantidad;
+        }
+        if (cantidad == 0) continue;
+        const auto& e = solucionador.obtenerEstadisticas();
+        cout << setw(7) << g[0] << "-" << setw(2) << g[1] << "     | " << setw(10) << cantidad << " | "
+             << setw(14) << fixed << setprecision(0) << (double)e.nodos / cantidad << " | " << setw(8)
+             << e.nodos / max(segundos, 1e-9) << " | " << setprecision(1)
+             << 100.0 * e.aciertos / max(1LL, e.consultas) << "%\n";
+    }
+
+    // Presupuesto de memoria: los finales más grandes con tablas de distinto tamaño
+    cout << "presupuesto | nodos totales | aciertos en tabla (finales de 17+ piezas)\n";
+    for (size_t bytes : {size_t(16) << 10, size_t(256) << 10, size_t(4) << 20, size_t(64) << 20}) {
+        SolucionadorFinal acotado(bytes);
+        double segundos = 0;
+        for (const auto& p : posiciones) {
+            if (contarBits(p.turno | p.rival) < 17) continue;
+            acotado.limpiarTabla();
+            auto t0 = chrono::steady_clock::now();
+            acotado.resolver(p.turno, p.rival, p.izq, p.der, false, nullptr);
+            segundos += chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+        }
+        const auto& e = acotado.obtenerEstadisticas();
+        cout << setw(8) << (acotado.bytesTabla() >> 10) << " KB | " << setw(13) << e.nodos << " | "
+             << setprecision(1) << 100.0 * e.aciertos / max(1LL, e.consultas) << "% ("
+             << setprecision(0) << e.nodos / max(segundos, 1e-9) << " nodos/s)\n";
+    }
+
+    // Efecto en el juego: final exacto contra el heurístico puro
+    const long long RONDAS = 20000;
+    vector<ParticipanteAutomatico*> mesa{new ParticipanteFinal("Final"), new ParticipanteHeuristico("Heuristico")};
+    vector<ParticipanteAutomatico*> control{new ParticipanteHeuristico("Final"), new ParticipanteHeuristico("Heuristico")};
+    SimuladorDomino conFinal(mesa, 4242), sinFinal(control, 4242);
+    auto t0 = chrono::steady_clock::now();
+    conFinal.jugarRondas(RONDAS);
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    sinFinal.jugarRondas(RONDAS);
+    cout << "final exacto vs heurístico: " << setprecision(1)
+         << 100.0 * conFinal.obtenerVictorias()[0] / RONDAS << "% de victorias, diferencia de puntos "
+         << (double)(conFinal.obtenerPuntuacion()[0] - conFinal.obtenerPuntuacion()[1]) / RONDAS
+         << " por ronda (heurístico vs heurístico: " << 100.0 * sinFinal.obtenerVictorias()[0] / RONDAS
+         << "%, " << (double)(sinFinal.obtenerPuntuacion()[0] - sinFinal.obtenerPuntuacion()[1]) / RONDAS
+         << "); " << setprecision(0) << RONDAS / segundos << " rondas/s\n";
+    for (auto p : mesa) delete p;
+    for (auto p : control) delete p;
+}
+
+// =========================
+// Benchmark del jugador ISMCTS: fuerza contra el codicioso y
+// simulaciones por segundo por núcleo
+// =========================
+void benchISMCTS() {
+    cout << "=== BENCH jugador ISMCTS ===\n";
+    const long long RONDAS = 400;
+    const long long ITERACIONES = 2000;  // Por hilo y por jugada: resultados reproducibles
+
+    // Fuerza: mismas barajadas para el ISMCTS y para el heurístico de referencia
+    struct Rival { const char* nombre; int jugadores; };
+    for (const Rival& r : {Rival{"1 codicioso", 2}, Rival{"3 codiciosos", 4}}) {
+        for (int usarISMCTS = 1; usarISMCTS >= 0; --usarISMCTS) {
+            vector<ParticipanteAutomatico*> mesa;
+            if (usarISMCTS) mesa.push_back(new ParticipanteISMCTS("Buscador", 1, 0, ITERACIONES));
+            else mesa.push_back(new ParticipanteHeuristico("Buscador"));
+            for (int j = 1; j < r.jugadores; ++j) mesa.push_back(new ParticipanteCodicioso("Codicioso" + to_string(j)));
+            SimuladorDomino simulador(mesa, 2718);
+            simulador.jugarRondas(RONDAS);
+            long long puntosRivales = 0;
+            for (int j = 1; j < r.jugadores; ++j) puntosRivales += simulador.obtenerPuntuacion()[j];
+            cout << (usarISMCTS ? "ISMCTS" : "heurístico") << " vs " << r.nombre << ": " << fixed
+                 << setprecision(1) << 100.0 * simulador.obtenerVictorias()[0] / RONDAS
+                 << "% de victorias (azar: " << 100.0 / r.jugadores << "%), puntos por ronda "
+                 << (double)simulador.obtenerPuntuacion()[0] / RONDAS << " contra "
+                 << (double)puntosRivales / RONDAS / (r.jugadores - 1) << " de cada rival\n";
+            for (auto p : mesa) delete p;
+        }
+    }
+
+    // Velocidad: jugadas con presupuesto de tiempo, con 1 hilo y con todos
+    unsigned nucleos = max(1u, thread::hardware_concurrency());
+    for (unsigned hilos : {1u, nucleos}) {
+        ParticipanteISMCTS* buscador = new ParticipanteISMCTS("Buscador", hilos, 10);
+        vector<ParticipanteAutomatico*> mesa{buscador, new ParticipanteCodicioso("C1"),
+                                             new ParticipanteCodicioso("C2"), new ParticipanteCodicioso("C3")};
+        SimuladorDomino simulador(mesa, 99);
+        simulador.jugarRondas(20);
+        const auto& e = buscador->obtenerEstadisticas();
+        cout << setw(2) << hilos << " hilo(s), 10 ms por jugada: " << e.decisiones << " jugadas, "
+             << setprecision(0) << e.iteraciones / e.segundos << " simulaciones/s, "
+             << e.iteraciones / e.segundos / min(hilos, nucleos) << " por núcleo\n";
+        for (auto p : mesa) delete p;
+        if (hilos == nucleos) break;
+    }
+}
+
+// =========================
+// Benchmark del servidor: servidor en un hilo y generador de carga en
+// otro, por socket Unix y por TCP local
+// =========================
+void benchServidor() {
+    cout << "=== BENCH servidor de mesas (epoll) ===\n";
+#if defined(__linux__)
+    const int CONEXIONES = 2000;
+    const double SEGUNDOS = 2;
+    string rutaUnix = "/tmp/bench_domino_" + to_string(getpid()) + ".sock";
+    for (int tcp = 0; tcp <= 1; ++tcp) {
+        ServidorDomino servidor;
+        if (!(tcp ? servidor.escucharTcp(0) : servidor.escucharUnix(rutaUnix))) {
+            cout << "No se pudo abrir el servidor\n";
+            return;
+        }
+        thread hiloServidor([&] { servidor.ejecutar(); });
+        string destino = tcp ? to_string(servidor.obtenerPuerto()) : rutaUnix;
+        ResultadoCarga r = generarCarga(destino, CONEXIONES, SEGUNDOS, 4);
+        servidor.detener();
+        hiloServidor.join();
+        mostrarCarga(tcp ? "TCP 127.0.0.1" : "socket Unix", r);
+        cout << "   servidor: " << servidor.obtenerJugadas() << " jugadas, "
+             << servidor.obtenerMesasTerminadas() << " mesas terminadas\n";
+    }
+#else
+    cout << "El servidor usa epoll: solo está disponible en Linux\n";
+#endif
+}
+
+// =========================
+// Benchmark de juegos grandes: costo de un turno (¿hay jugada? y
+// ¿qué pieza encaja?) de doble seis a doble quince, con el índice por
+// valor y recorriendo la mano como referencia
+// =========================
+void benchConjuntos() {
+    cout << "=== BENCH juegos doble-N (índice por valor) ===\n";
+    const int CONSULTAS = 4000000;
+    cout << "juego      | piezas | mano | índice: ns por turno | recorrido: ns por turno\n";
+    for (int maximo : {6, 9, 12, 15}) {
+        vector<PiezaDomino> conjunto;
+        for (int a = 0; a <= maximo; ++a)
+            for (int b = a; b <= maximo; ++b) conjunto.emplace_back(a, b);
+        GeneradorRapido azar((uint64_t)maximo);
+        shuffle(conjunto.begin(), conjunto.end(), azar);
+
+        // Mano después de algunos robos: el doble de lo repartido
+        int tamMano = 2 * piezasPorManoPara(maximo);
+        ParticipanteHumano jugador("Bench");
+        for (int i = 0; i < tamMano; ++i) jugador.tomarPieza(conjunto[i]);
+        vector<int> extremos(2 * CONSULTAS);
+        for (auto& e : extremos) e = (int)azar.menorQue((uint32_t)maximo + 1);
+
+        // Índice: dos consultas de conteo y, si hay, la primera pieza de la lista
+        long long control = 0;
+        auto t0 = chrono::steady_clock::now();
+        for (int q = 0; q < CONSULTAS; ++q) {
+            int izq = extremos[2 * q], der = extremos[2 * q + 1];
+            if (jugador.tieneJugada(izq, der)) {
+                const auto& lista = jugador.piezasConValor(izq).empty() ? jugador.piezasConValor(der)
+                                                                         : jugador.piezasConValor(izq);
+                control += lista.front().totalPuntos();
+            }
+        }
+        double nsIndice = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / CONSULTAS;
+
+        // Referencia: recorrer la mano hasta encontrar una pieza que encaje
+        long long controlLineal = 0;
+        t0 = chrono::steady_clock::now();
+        for (int q = 0; q < CONSULTAS; ++q) {
+            int izq = extremos[2 * q], der = extremos[2 * q + 1];
+            for (int i = 0; i < jugador.cantidadPiezas(); ++i) {
+                const PiezaDomino& p = jugador.verPieza(i);
+                if (p.obtenerIzquierdo() == izq || p.obtenerDerecho() == izq ||
+                    p.obtenerIzquierdo() == der || p.obtenerDerecho() == der) {
+                    controlLineal += p.totalPuntos();
+                    break;
+                }
+            }
+        }
+        double nsLineal = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / CONSULTAS;
+
+        cout << "doble " << setw(2) << maximo << "   | " << setw(6) << conjunto.size() << " | " << setw(4) << tamMano
+             << " | " << setw(20) << fixed << setprecision(1) << nsIndice << " | " << setw(23) << nsLineal
+             << "   (control " << (control + controlLineal) % 997 << ")\n";
+    }
+
+}
+
+// =========================
+// Benchmark de la telemetría: rondas de PartidaDomino con jugadores
+// automáticos (salida de consola descartada). Compilando con y sin
+// -DDOMINO_TELEMETRIA=1 se compara con la medición sin instrumentar.
+// =========================
+void benchTelemetria() {
+    cout << "=== BENCH telemetría de PartidaDomino (" << (TELEMETRIA_ACTIVA ? "activa" : "desactivada")
+         << ") ===\n";
+    const long long RONDAS = 100000;
+    PartidaDomino partida(11);
+    partida.configurarParticipantes({new ParticipanteHeuristico("Heuristico"), new ParticipanteCodicioso("Codicioso"),
+                                     new ParticipanteAleatorio("Aleatorio")});
+
+    streambuf* consola = cout.rdbuf(nullptr);
+    auto t0 = chrono::steady_clock::now();
+    for (long long r = 0; r < RONDAS; ++r) partida.ejecutarRonda();
+    double segundos = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    cout.rdbuf(consola);
+    cout.clear();
+    cout << fixed << setprecision(0) << RONDAS / segundos << " rondas/s de PartidaDomino\n";
+
+    if constexpr (TELEMETRIA_ACTIVA) {
+        // Costo de un punto de medición: la lectura del reloj al terminar
+        // el turno y el histograma (más otra lectura al empezarlo)
+        TelemetriaPartida prueba;
+        prueba.reiniciar({"x"});
+        const int MEDICIONES = 2000000;
+        t0 = chrono::steady_clock::now();
+        auto antes = chrono::steady_clock::now();
+        for (int i = 0; i < MEDICIONES; ++i) prueba.registrarTurno(0, antes, i & 1, true);
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / MEDICIONES;
+        const TelemetriaEnUso& t = partida.obtenerTelemetria();
+        cout << "costo por turno medido: " << setprecision(1) << ns << " ns ("
+             << 100.0 * ns * t.turnos / (segundos * 1e9) << "% del tiempo de la prueba)\n";
+        string json = partida.telemetriaJSON();
+        cout << json;
+    }
+}
+
+// =========================
+// Benchmark del estado plano: capturar, clonar, restaurar, guardar y
+// cargar, y comprobación de que una ronda restaurada a medias termina
+// igual que la original
+// =========================
+void benchEstado() {
+    cout << "=== BENCH estado plano de PartidaDomino (" << sizeof(EstadoPartida) << " bytes) ===\n";
+    PartidaDomino partida(5);
+    partida.configurarParticipantes({new ParticipanteHeuristico("Ana"), new ParticipanteCodicioso("Beto"),
+                                     new ParticipanteAleatorio("Carla")});
+    GeneradorRapido azar(99);
+    streambuf* consola = cout.rdbuf(nullptr);
+
+    // Cortar cada ronda en un turno al azar, terminarla, volver al corte
+    // y terminarla otra vez: manos, mesa y puntajes deben coincidir
+    const int RONDAS = 2000;
+    int comparadas = 0, distintas = 0;
+    EstadoPartida corte, original, repetido;
+    for (int r = 0; r < RONDAS; ++r) {
+        partida.empezarRonda();
+        for (uint32_t t = azar.menorQue(20); t > 0 && partida.jugarTurno() == PartidaDomino::TURNO_SIGUE; --t) {}
+        if (!partida.hayRondaEnCurso()) continue;  // Terminó antes del corte
+        comparadas++;
+        partida.capturarEstado(corte);
+        partida.procesarPuntuacion(partida.ejecutarRonda());
+        partida.capturarEstado(original);
+        if (!partida.restaurarEstado(corte)) { distintas++; continue; }
+        partida.procesarPuntuacion(partida.ejecutarRonda());
+        partida.capturarEstado(repetido);
+        distintas += memcmp(&original, &repetido, sizeof(EstadoPartida)) != 0;
+    }
+
+    // Un corte con ronda en curso para medir
+    partida.empezarRonda();
+    for (int t = 0; t < 6; ++t) partida.jugarTurno();
+    cout.rdbuf(consola);
+    cout.clear();
+    partida.capturarEstado(corte);
+    cout << comparadas << " rondas retomadas desde un turno al azar: " << distintas << " distintas de la original\n";
+
+    const int REPETICIONES = 1000000;
+    static EstadoPartida copias[64];
+    long long control = 0;
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < REPETICIONES; ++i) {
+        copias[i & 63] = corte;
+        control += copias[i & 63].tamPozo;
+    }
+    double nsClonar = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / REPETICIONES;
+
+    t0 = chrono::steady_clock::now();
+    for (int i = 0; i < REPETICIONES; ++i) {
+        partida.capturarEstado(copias[i & 63]);
+        control += copias[i & 63].tamTablero;
+    }
+    double nsCapturar = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / REPETICIONES;
+
+    const int RESTAURACIONES = 200000;
+    t0 = chrono::steady_clock::now();
+    for (int i = 0; i < RESTAURACIONES; ++i) control += partida.restaurarEstado(corte);
+    double nsRestaurar = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / RESTAURACIONES;
+
+    EstadoSimulado simulado;
+    t0 = chrono::steady_clock::now();
+    for (int i = 0; i < REPETICIONES; ++i) {
+        corte.aSimulado(simulado);
+        control += simulado.manos[i & 1];
+    }
+    double nsSimulado = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / REPETICIONES;
+
+    cout << fixed << setprecision(1) << "clonar: " << nsClonar << " ns, capturar: " << nsCapturar
+         << " ns, restaurar: " << nsRestaurar << " ns, a EstadoSimulado: " << nsSimulado << " ns\n";
+
+    const int ARCHIVOS = 1000;
+    const string ruta = "bench_estado.dom";
+    EstadoPartida leido;
+    bool iguales = true;
+    t0 = chrono::steady_clock::now();
+    for (int i = 0; i < ARCHIVOS; ++i) {
+        iguales &= corte.guardar(ruta) && leido.cargar(ruta);
+        iguales &= memcmp(&corte, &leido, sizeof(EstadoPartida)) == 0;
+    }
+    double usArchivo = chrono::duration<double, micro>(chrono::steady_clock::now() - t0).count() / ARCHIVOS;
+    remove(ruta.c_str());
+    cout << "guardar y cargar de disco: " << usArchivo << " us (" << (iguales ? "idéntico" : "DISTINTO")
+         << ") [control " << (control & 1) << "]\n";
+}
+
+// =========================
+// Contador de reservas de memoria
+// Reemplaza el operator new global: solo cuenta mientras contandoReservas
+// está activo (fuera de benchReservas cuesta una lectura de un bool).
+// =========================
+static atomic<bool> contandoReservas{false};
+static atomic<long long> reservasContadas{0};
+
+// GCC ve malloc/free a través del new y delete reemplazados y avisa de
+// un par mal emparejado que no existe
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic push
+    #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t n) {
+    if (contandoReservas.load(memory_order_relaxed)) reservasContadas.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(n ? n : 1)) return p;
+    throw bad_alloc();
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+    #pragma GCC diagnostic pop
+#endif
+
+// =========================
+// Rondas de PartidaDomino sin reservas de memoria: tras unas rondas de
+// calentamiento (vectores y mesa ya con su capacidad), barajar, repartir,
+// jugar y puntuar no deben pedir memoria. Devuelve cuántas reservas
+// hicieron 'rondas' rondas de doble-'doble' y en 'segundos' lo que tardaron
+// =========================
+long long reservasEnRondas(int doble, int rondas, double& segundos) {
+    PartidaDomino partida(21);
+    partida.configurarConjunto(doble);
+    partida.configurarParticipantes({new ParticipanteHeuristico("Heuristico"),
+                                     new ParticipanteCodicioso("Codicioso con nombre largo"),
+                                     new ParticipanteAleatorio("Aleatorio")});
+    const int CALENTAMIENTO = 1000;
+    streambuf* consola = cout.rdbuf(nullptr);
+    for (int r = 0; r < CALENTAMIENTO; ++r) partida.procesarPuntuacion(partida.ejecutarRonda());
+
+    reservasContadas = 0;
+    contandoReservas = true;
+    auto t0 = chrono::steady_clock::now();
+    for (int r = 0; r < rondas; ++r) partida.procesarPuntuacion(partida.ejecutarRonda());
+    segundos = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+    contandoReservas = false;
+    cout.rdbuf(consola);
+    cout.clear();
+    return reservasContadas;
+}
+
+// Velocidad de las mismas rondas (la ausencia de reservas la comprueba --pruebas)
+void benchReservas() {
+    cout << "=== BENCH reservas de memoria por ronda de PartidaDomino ===\n";
+    const int RONDAS = 100000;
+    for (int doble : {6, 15}) {
+        double segundos;
+        long long reservas = reservasEnRondas(doble, RONDAS, segundos);
+        cout << "doble " << doble << ": " << fixed << setprecision(0) << RONDAS / segundos << " rondas/s, "
+             << reservas << " reservas en " << RONDAS << " rondas\n";
+    }
+}
+
+// =========================
+// Resumen de un registro (./juego --reproducir archivo)
+// =========================
+bool mostrarRegistro(const string& ruta) {
+    LectorRegistro lector(ruta);
+    if (!lector.valido()) {
+        cout << "No se pudo leer el registro " << ruta << "\n";
+        return false;
+    }
+    ReproductorPartida reproductor;
+    for (size_t i = 0; i < lector.totalPartidas(); ++i) {
+        reproductor.cargar(lector.datosPartida(i), lector.tamanoPartida(i));
+        bool ok = reproductor.reproducirTodo();
+        cout << "Partida " << (i + 1) << ": " << reproductor.movimientoActual() << " movimientos, ";
+        if (!ok) {
+            cout << "evento inválido tras ese movimiento\n";
+            continue;
+        }
+        cout << (reproductor.terminoPorBloqueo() ? "bloqueo" : "dominó") << ", el ganador suma "
+             << reproductor.puntosGanador() << " puntos\n   Tablero: ";
+        for (const auto& p : reproductor.tablero()) cout << p.comoTexto();
+        cout << "\n   Puntos en mano:";
+        for (int j = 0; j < reproductor.jugadores(); ++j)
+            cout << " J" << (j + 1) << "=" << puntosDe(reproductor.manoDe(j));
+        cout << "\n";
+    }
+    if (lector.estaTruncado()) cout << "(la última partida está incompleta)\n";
+    return true;
+}
+
+// =========================
+// Pruebas de regresión: ./juego --pruebas
+// Cada comprobación imprime OK o FALLA; el programa termina con código 1
+// si alguna falló
+// =========================
+int pruebasFallidas = 0;
+
+void comprobar(bool condicion, const string& descripcion) {
+    cout << (condicion ? "  OK    " : "  FALLA ") << descripcion << "\n";
+    if (!condicion) pruebasFallidas++;
+}
+
+// Jugador automático que revisa cada uno de sus turnos: solo roba si no
+// tenía jugada, solo pasa con el pozo vacío y sin jugada, y la pieza
+// colocada sale de su mano y encaja en el extremo elegido
+struct RevisionJugadas {
+    long long turnos = 0;
+    long long ilegales = 0;
+    int valorMayor = 0;  // Mayor valor visto en la mesa
+};
+
+template <class Base>
+class ParticipanteRevisado : public Base {
+private:
+    RevisionJugadas& revision;
+public:
+    ParticipanteRevisado(const string& nombre_, RevisionJugadas& revision_) : Base(nombre_), revision(revision_) {}
+
+    bool realizarJugada(MesaDomino& tablero, vector<PiezaDomino>& pozo, int extremoIzq, int extremoDer,
+                        const EstadoVisible& visible) override {
+        int izq = tablero.empty() ? -1 : extremoIzq, der = tablero.empty() ? -1 : extremoDer;
+        bool teniaJugada = this->tieneJugada(izq, der);
+        size_t pozoAntes = pozo.size(), mesaAntes = tablero.size();
+        int manoAntes = this->cantidadPiezas();
+        PiezaDomino frenteAntes = tablero.empty() ? PiezaDomino() : tablero.front();
+
+        bool jugo = Base::realizarJugada(tablero, pozo, extremoIzq, extremoDer, visible);
+
+        int robadas = (int)(pozoAntes - pozo.size());
+        bool legal = !(teniaJugada && robadas > 0);
+        if (jugo) {
+            legal = legal && tablero.size() == mesaAntes + 1 && this->cantidadPiezas() == manoAntes + robadas - 1;
+            if (legal && mesaAntes > 0) {
+                bool izquierda = !tablero.front().esIgualA(frenteAntes);
+                legal = izquierda ? tablero.front().obtenerDerecho() == extremoIzq
+                                  : tablero.back().obtenerIzquierdo() == extremoDer;
+            }
+            for (size_t k = 0; legal && k + 1 < tablero.size(); ++k)
+                legal = tablero[k].obtenerDerecho() == tablero[k + 1].obtenerIzquierdo();
+        } else {
+            legal = legal && pozo.empty() && tablero.size() == mesaAntes && !this->tieneJugada(izq, der);
+        }
+        for (const auto& p : tablero)
+            revision.valorMayor = max(revision.valorMayor, max(p.obtenerIzquierdo(), p.obtenerDerecho()));
+        revision.turnos++;
+        if (!legal) revision.ilegales++;
+        return jugo;
+    }
+};
+
+// Partidas completas de doble 9, 12 y 15 con jugadores automáticos
+void pruebaConjuntosConBots() {
+    cout << "=== PRUEBA jugadores automáticos en juegos doble-N ===\n";
+    for (int doble : {9, 12, 15}) {
+        RevisionJugadas revision;
+        PartidaDomino partida(7);
+        partida.configurarConjunto(doble);
+        partida.configurarParticipantes({new ParticipanteRevisado<ParticipanteHeuristico>("Heuristico", revision),
+                                         new ParticipanteRevisado<ParticipanteCodicioso>("Codicioso", revision),
+                                         new ParticipanteRevisado<ParticipanteAleatorio>("Aleatorio", revision),
+                                         new ParticipanteRevisado<ParticipanteFinal>("Final", revision)});
+        streambuf* consola = cout.rdbuf(nullptr);
+        for (int r = 0; r < 200; ++r) partida.procesarPuntuacion(partida.ejecutarRonda());
+        cout.rdbuf(consola);
+        cout.clear();
+        comprobar(revision.ilegales == 0 && revision.valorMayor == doble,
+                  "doble " + to_string(doble) + ": 200 rondas, " + to_string(revision.turnos) + " turnos, " +
+                  to_string(revision.ilegales) + " jugadas ilegales");
+    }
+    cout << "\n";
+}
+
+// Un escritor sin archivo acepta eventos sin salirse de su búfer
+void pruebaRegistroInvalido() {
+    cout << "=== PRUEBA EscritorRegistro sin archivo ===\n";
+    EscritorRegistro escritor("/directorio/que/no/existe/partidas.dlog");
+    comprobar(!escritor.valido(), "no se pudo abrir: valido() es false");
+    for (size_t i = 0; i < 4 * EscritorRegistro::TAM_BUFER; ++i) escritor.pase();
+    comprobar(escritor.obtenerMovimientos() == 4 * (long long)EscritorRegistro::TAM_BUFER &&
+              escritor.obtenerBytes() < (long long)EscritorRegistro::TAM_BUFER,
+              "256 KiB de eventos se descartan sin desbordar el búfer");
+    escritor.cerrar();
+    escritor.pase();
+    comprobar(!escritor.cerrar(), "tras cerrar() sigue siendo inválido");
+    cout << "\n";
+}
+
+// Misma semilla, mismas partidas, también con jugadores al azar
+void pruebaSemillaReproducible() {
+    cout << "=== PRUEBA PartidaDomino reproducible con semilla ===\n";
+    EstadoPartida estados[2];
+    for (int k = 0; k < 2; ++k) {
+        PartidaDomino partida(31);
+        partida.configurarParticipantes({new ParticipanteAleatorio("Ana"), new ParticipanteAleatorio("Beto"),
+                                         new ParticipanteCodicioso("Carla")});
+        streambuf* consola = cout.rdbuf(nullptr);
+        for (int r = 0; r < 100; ++r) partida.procesarPuntuacion(partida.ejecutarRonda());
+        cout.rdbuf(consola);
+        cout.clear();
+        partida.capturarEstado(estados[k]);
+    }
+    comprobar(memcmp(&estados[0], &estados[1], sizeof(EstadoPartida)) == 0,
+              "dos partidas con semilla 31 terminan 100 rondas en el mismo estado");
+    cout << "\n";
+}
+
+// Un archivo armado a mano con tamaños mayores que el juego se rechaza
+// sin leer fuera de los arreglos del estado
+void pruebaEstadoInvalido() {
+    cout << "=== PRUEBA EstadoPartida con tamaños fuera de rango ===\n";
+    PartidaDomino partida(3);
+    partida.configurarConjunto(15);
+    partida.configurarParticipantes({new ParticipanteHeuristico("Ana"), new ParticipanteCodicioso("Beto"),
+                                     new ParticipanteAleatorio("Carla"), new ParticipanteAleatorio("Dario")});
+    streambuf* consola = cout.rdbuf(nullptr);
+    partida.empezarRonda();
+    for (int t = 0; t < 10; ++t) partida.jugarTurno();
+    cout.rdbuf(consola);
+    cout.clear();
+    EstadoPartida valido;
+    partida.capturarEstado(valido);
+    comprobar(valido.esValido(), "el estado capturado a mitad de ronda es válido");
+
+    EstadoPartida e = valido;
+    e.tamMano[3] = 255;
+    comprobar(!e.esValido(), "una mano de 255 piezas se rechaza");
+    e = valido;
+    e.tamPozo = 200;
+    comprobar(!e.esValido(), "un pozo de 200 piezas se rechaza");
+    e = valido;
+    e.tamTablero = 137;
+    comprobar(!e.esValido(), "una mesa de 137 piezas se rechaza");
+    e = valido;
+    e.tamMazo = 255;
+    comprobar(!e.esValido(), "un mazo de 255 piezas se rechaza");
+    cout << "\n";
+}
+
+// Tras el calentamiento, una ronda de PartidaDomino no pide memoria
+void pruebaRondaSinReservas() {
+    cout << "=== PRUEBA rondas de PartidaDomino sin reservas de memoria ===\n";
+    for (int doble : {6, 15}) {
+        double segundos;
+        long long reservas = reservasEnRondas(doble, 10000, segundos);
+        comprobar(reservas == 0, "doble " + to_string(doble) + ": 10000 rondas, " + to_string(reservas) + " reservas");
+    }
+    cout << "\n";
+}
+
+// En la mesa de PartidaDomino el jugador final sabe cuántos juegan: con
+// dos jugadores y el pozo agotado tiene que resolver la posición
+void pruebaFinalEnPartida() {
+    cout << "=== PRUEBA ParticipanteFinal en PartidaDomino ===\n";
+    PartidaDomino partida(17);
+    ParticipanteFinal* final = new ParticipanteFinal("Ana", 1u << 20);
+    partida.configurarParticipantes({final, new ParticipanteHeuristico("Beto")});
+    streambuf* consola = cout.rdbuf(nullptr);
+    for (int r = 0; r < 20; ++r) partida.procesarPuntuacion(partida.ejecutarRonda());
+    cout.rdbuf(consola);
+    cout.clear();
+    comprobar(final->obtenerSolucionador().obtenerEstadisticas().nodos > 0,
+              "el solucionador se usa con dos jugadores y el pozo vacío");
+    cout << "\n";
+}
+
+// ISMCTS sentado en una PartidaDomino busca de verdad (antes solo
+// devolvía la primera jugada legal)
+void pruebaISMCTSEnPartida() {
+    cout << "=== PRUEBA ParticipanteISMCTS en PartidaDomino ===\n";
+    PartidaDomino partida(23);
+    ParticipanteISMCTS* ismcts = new ParticipanteISMCTS("Ana", 1, 0, 200);
+    partida.configurarParticipantes({ismcts, new ParticipanteHeuristico("Beto"),
+                                     new ParticipanteAleatorio("Carla")});
+    streambuf* consola = cout.rdbuf(nullptr);
+    for (int r = 0; r < 3; ++r) partida.procesarPuntuacion(partida.ejecutarRonda());
+    cout.rdbuf(consola);
+    cout.clear();
+    const auto& e = ismcts->obtenerEstadisticas();
+    comprobar(e.decisiones > 0 && e.iteraciones >= 200 * e.decisiones,
+              "cada decisión con más de una jugada corre sus 200 iteraciones");
+    cout << "\n";
+}
+
+// =========================
+// MAIN
 // =========================
-// MAIN
-// =========================
-int main() {
-    PartidaDomino partida;
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--pruebas") {
+        pruebaConjuntosConBots();
+        pruebaSemillaReproducible();
+        pruebaRegistroInvalido();
+        pruebaEstadoInvalido();
+        pruebaRondaSinReservas();
+        pruebaFinalEnPartida();
+        pruebaISMCTSEnPartida();
+        cout << (pruebasFallidas == 0 ? "Todas las pruebas pasaron" : "Hay pruebas fallidas") << "\n";
+        return pruebasFallidas == 0 ? 0 : 1;
+    }
+
+    if (argc > 1 && string(argv[1]) == "--bench") {
+        benchSimulador();
+        benchTorneo();
+        benchRegistro();
+        benchFinal();
+        benchISMCTS();
+        benchServidor();
+        benchConjuntos();
+        benchTelemetria();
+        benchEstado();
+        benchReservas();
+        return 0;
+    }
+
+#if defined(__linux__)
+    // Servidor de mesas hasta Ctrl+C: ./juego --servidor 5555 (o una ruta de socket Unix)
+    if (argc > 2 && string(argv[1]) == "--servidor") {
+        static ServidorDomino servidor;
+        if (!servidor.escuchar(argv[2])) {
+            cout << "No se pudo escuchar en " << argv[2] << "\n";
+            return 1;
+        }
+        signal(SIGINT, [](int) { servidor.detener(); });
+        cout << "Servidor de mesas en " << argv[2] << " (Ctrl+C para terminar)\n";
+        servidor.ejecutar();
+        cout << servidor.obtenerJugadas() << " jugadas, " << servidor.obtenerMesasTerminadas() << " mesas terminadas\n";
+        return 0;
+    }
+
+    // Generador de carga: ./juego --carga 5555 [conexiones] [segundos] [jugadores por mesa]
+    if (argc > 2 && string(argv[1]) == "--carga") {
+        int conexiones = argc > 3 ? stoi(argv[3]) : 1000;
+        double segundos = argc > 4 ? stod(argv[4]) : 5;
+        int jugadores = argc > 5 ? stoi(argv[5]) : 4;
+        ResultadoCarga r = generarCarga(argv[2], conexiones, segundos, jugadores);
+        if (r.conexiones == 0) {
+            cout << "No se pudo conectar a " << argv[2] << "\n";
+            return 1;
+        }
+        mostrarCarga(argv[2], r);
+        return 0;
+    }
+#endif
+
+    if (argc > 2 && string(argv[1]) == "--reproducir")
+        return mostrarRegistro(argv[2]) ? 0 : 1;
+
+    // Opciones combinables: --semilla N, --registro archivo, --doble N (6, 9, 12 o 15)
+    // y --continuar archivo (partida guardada con la opción 6 del menú)
+    unsigned semilla = (unsigned)time(nullptr);
+    string rutaRegistro, rutaContinuar;
+    int doble = VALOR_MAXIMO;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        string opcion = argv[i];
+        if (opcion == "--semilla") semilla = (unsigned)stoul(argv[i + 1]);
+        else if (opcion == "--registro") rutaRegistro = argv[i + 1];
+        else if (opcion == "--doble") doble = stoi(argv[i + 1]);
+        else if (opcion == "--continuar") rutaContinuar = argv[i + 1];
+    }
+
+    PartidaDomino partida(semilla);
+    if (!partida.configurarConjunto(doble)) {
+        cout << "Juego no soportado: use --doble 6, 9, 12 o 15\n";
+        return 1;
+    }
+    unique_ptr<EscritorRegistro> registro;
+    if (!rutaRegistro.empty()) {
+        registro.reset(new EscritorRegistro(rutaRegistro));
+        if (!registro->valido()) {
+            cout << "No se pudo crear el registro " << rutaRegistro << "\n";
+            return 1;
+        }
+        partida.registrarEn(registro.get());
+    }
+    if (!rutaContinuar.empty()) {
+        if (!partida.continuarDesde(rutaContinuar)) {
+            cout << "No se pudo retomar la partida de " << rutaContinuar << "\n";
+            return 1;
+        }
+        return 0;
+    }
     partida.iniciar();
     return 0;
 }
\ No newline at end of file